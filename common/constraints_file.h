@@ -0,0 +1,69 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _CONSTRAINTS_FILE_H_
+#define _CONSTRAINTS_FILE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <string>
+
+// Size, number of lines and 64-bit FNV-1a hash of a constraints file, which
+// are logged in place of the whole content of the file. A line is counted
+// with its first character, so the last line is counted even if it's not
+// terminated with a newline.
+struct FileDigest {
+    size_t size = 0;
+    size_t lines = 0;
+    uint64_t hash = 0xcbf29ce484222325;
+    bool in_line = false;
+
+    void update(const char *data, size_t count)
+    {
+        for (size_t idx = 0; idx < count; idx++) {
+            hash = (hash ^ static_cast<unsigned char>(data[idx])) * 0x100000001b3;
+            if (!in_line) {
+                lines++;
+                in_line = true;
+            }
+            in_line = data[idx] != '\n';
+        }
+        size += count;
+    }
+
+    std::string str() const
+    {
+        char hash_str[17];
+        std::snprintf(hash_str, sizeof(hash_str), "%016llx", static_cast<unsigned long long>(hash));
+        return std::to_string(size) + " bytes, " + std::to_string(lines) + " lines, FNV-1a hash " + hash_str;
+    }
+};
+
+// Read the whole stream in large blocks computing its digest on the way
+inline std::string read_constraints_file(std::istream &f, FileDigest &digest)
+{
+    std::string content;
+    char buffer[64 * 1024];
+    while (f.read(buffer, sizeof(buffer)) || f.gcount() > 0) {
+        digest.update(buffer, f.gcount());
+        content.append(buffer, f.gcount());
+    }
+    return content;
+}
+
+#endif // _CONSTRAINTS_FILE_H_
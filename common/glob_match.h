@@ -0,0 +1,56 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _GLOB_MATCH_H_
+#define _GLOB_MATCH_H_
+
+#include <string>
+
+// Check if the name is a glob pattern with the '*' and '?' wildcards. Square
+// brackets are taken literally, as they are part of the bus bit names.
+inline bool IsGlob(const std::string &pattern) { return pattern.find_first_of("*?") != std::string::npos; }
+
+// Match the name against a glob pattern with the '*' and '?' wildcards in
+// linear time, backtracking only to the last '*'
+inline bool GlobMatch(const std::string &pattern, const std::string &name)
+{
+    size_t pattern_pos = 0;
+    size_t name_pos = 0;
+    // Position of the last '*' in the pattern and of the name character it was matched up to
+    size_t star_pos = std::string::npos;
+    size_t star_name_pos = 0;
+    while (name_pos < name.size()) {
+        if (pattern_pos < pattern.size() and (pattern[pattern_pos] == '?' or pattern[pattern_pos] == name[name_pos])) {
+            pattern_pos++;
+            name_pos++;
+        } else if (pattern_pos < pattern.size() and pattern[pattern_pos] == '*') {
+            star_pos = pattern_pos++;
+            star_name_pos = name_pos;
+        } else if (star_pos != std::string::npos) {
+            pattern_pos = star_pos + 1;
+            name_pos = ++star_name_pos;
+        } else {
+            return false;
+        }
+    }
+    while (pattern_pos < pattern.size() and pattern[pattern_pos] == '*') {
+        pattern_pos++;
+    }
+    return pattern_pos == pattern.size();
+}
+
+#endif // _GLOB_MATCH_H_
@@ -0,0 +1,53 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _TCL_LIST_H_
+#define _TCL_LIST_H_
+
+#include "kernel/yosys.h"
+#include <string>
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+// Split a Tcl list, e.g. "a {b[0]} c", into its elements
+inline std::vector<std::string> SplitTclList(const std::string &list)
+{
+    int count;
+    const char **elements;
+    if (Tcl_SplitList(yosys_get_tcl_interp(), list.c_str(), &count, &elements) != TCL_OK) {
+        log_cmd_error("Incorrect Tcl list %s: %s\n", list.c_str(), Tcl_GetStringResult(yosys_get_tcl_interp()));
+    }
+    std::vector<std::string> result(elements, elements + count);
+    Tcl_Free(reinterpret_cast<char *>(elements));
+    return result;
+}
+
+// Merge the elements into a Tcl list with the elements quoted where needed
+inline std::string MergeTclList(const std::vector<std::string> &elements)
+{
+    std::vector<const char *> elements_ptrs;
+    for (auto &element : elements) {
+        elements_ptrs.push_back(element.c_str());
+    }
+    char *merged = Tcl_Merge(elements_ptrs.size(), elements_ptrs.data());
+    std::string result(merged);
+    Tcl_Free(merged);
+    return result;
+}
+
+#endif // _TCL_LIST_H_
@@ -0,0 +1,53 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _TCL_SCRIPT_FILE_H_
+#define _TCL_SCRIPT_FILE_H_
+
+#include "kernel/yosys.h"
+#include <string>
+
+// Set the file name returned by [info script] while the content of a constraints
+// file is evaluated from memory, the same as it's set by Tcl_EvalFile. This way
+// the constraints can still source other files relative to their own location.
+// The previous script file name is restored when the object goes out of scope.
+class TclScriptFile
+{
+  public:
+    TclScriptFile(Tcl_Interp *interp, const std::string &filename) : interp_(interp)
+    {
+        Tcl_Eval(interp_, "info script");
+        previous_filename_ = Tcl_GetStringResult(interp_);
+        SetFilename(filename);
+    }
+
+    ~TclScriptFile() { SetFilename(previous_filename_); }
+
+  private:
+    void SetFilename(const std::string &filename)
+    {
+        const char *argv[] = {"info", "script", filename.c_str()};
+        char *command = Tcl_Merge(3, argv);
+        Tcl_Eval(interp_, command);
+        Tcl_Free(command);
+    }
+
+    Tcl_Interp *interp_;
+    std::string previous_filename_;
+};
+
+#endif // _TCL_SCRIPT_FILE_H_
@@ -0,0 +1,92 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _TOP_PORTS_H_
+#define _TOP_PORTS_H_
+
+#include "glob_match.h"
+#include "kernel/rtlil.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+// Names of the bits of the top ports as given in the constraints. A single bit
+// port starting at index 0 is named after the port, the bits of the other
+// ports have their index appended, e.g. "led[3]".
+inline std::vector<std::pair<std::string, RTLIL::SigBit>> TopPortBits(RTLIL::Module *module)
+{
+    std::vector<std::pair<std::string, RTLIL::SigBit>> port_bits;
+    for (auto &port : module->ports) {
+        RTLIL::Wire *wire = module->wire(port);
+        std::string name(RTLIL::unescape_id(port));
+        if (wire->width == 1 and wire->start_offset == 0) {
+            port_bits.emplace_back(name, RTLIL::SigBit(wire, 0));
+            continue;
+        }
+        for (int i = 0; i < wire->width; i++) {
+            port_bits.emplace_back(name + "[" + std::to_string(wire->start_offset + i) + "]", RTLIL::SigBit(wire, i));
+        }
+    }
+    return port_bits;
+}
+
+// Find the top port bit of a name, e.g. "led[3]". A name without an index
+// refers to the bit 0 of the port.
+inline bool FindTopPortBit(RTLIL::Module *module, const std::string &port_name, RTLIL::SigBit &bit)
+{
+    std::string port_str(port_name.size(), '\0');
+    int index(0);
+    if (!sscanf(port_name.c_str(), "%[^[][%d]", &port_str[0], &index)) {
+        return false;
+    }
+    port_str.resize(strlen(port_str.c_str()));
+    RTLIL::Wire *wire = module->wire(RTLIL::escape_id(port_str));
+    if (!wire or (!wire->port_input and !wire->port_output) or index < wire->start_offset or index >= wire->start_offset + wire->width) {
+        return false;
+    }
+    bit = RTLIL::SigBit(wire, index - wire->start_offset);
+    return true;
+}
+
+// Find the top port bits of a name or of a glob pattern with the '*' and '?'
+// wildcards. The patterns are matched against the port bits given by
+// TopPortBits, which are listed once for all the patterns.
+inline std::vector<std::pair<std::string, RTLIL::SigBit>> MatchTopPorts(RTLIL::Module *module,
+                                                                        const std::vector<std::pair<std::string, RTLIL::SigBit>> &port_bits,
+                                                                        const std::string &port_name)
+{
+    std::vector<std::pair<std::string, RTLIL::SigBit>> matches;
+    if (!IsGlob(port_name)) {
+        RTLIL::SigBit bit;
+        if (FindTopPortBit(module, port_name, bit)) {
+            matches.emplace_back(port_name, bit);
+        }
+        return matches;
+    }
+    for (auto &port : port_bits) {
+        if (GlobMatch(port_name, port.first)) {
+            matches.push_back(port);
+        }
+    }
+    return matches;
+}
+
+#endif // _TOP_PORTS_H_
@@ -18,7 +18,8 @@
  *
  */
 #include "get_ports.h"
-#include "../common/utils.h"
+#include "../common/tcl_list.h"
+#include "../common/top_ports.h"
 
 USING_YOSYS_NAMESPACE
 
@@ -30,26 +31,25 @@ void GetPorts::ExecuteSelection([[gnu::unused]] RTLIL::Design *design, [[gnu::un
 
 GetPorts::SelectionObjects GetPorts::ExtractSelection(RTLIL::Design *design, const CommandArgs &args)
 {
-    std::string port_name = args.selection_objects.at(0);
-    trim(port_name);
-    std::string port_str(port_name.size(), '\0');
-    int bit(0);
-    if (!sscanf(port_name.c_str(), "%[^[][%d]", &port_str[0], &bit)) {
-        log_error("Couldn't find port %s\n", port_name.c_str());
-    }
-
-    port_str.resize(strlen(port_str.c_str()));
-    RTLIL::IdString port_id(RTLIL::escape_id(port_str));
+    // The ports are resolved like in the set_property commands read natively
+    // by read_xdc: every argument is a list of port names and glob patterns
+    // matching the port bits, e.g. "led[*]"
+    RTLIL::Module *top_module = design->top_module();
+    std::vector<std::pair<std::string, RTLIL::SigBit>> port_bits;
     SelectionObjects objects;
-    if (auto wire = design->top_module()->wire(port_id)) {
-        if (wire->port_input || wire->port_output) {
-            if (bit >= wire->start_offset && bit < wire->start_offset + wire->width) {
-                objects.push_back(port_name);
+    for (auto &selection : args.selection_objects) {
+        for (auto &port_name : SplitTclList(selection)) {
+            if (IsGlob(port_name) and port_bits.empty()) {
+                port_bits = TopPortBits(top_module);
+            }
+            auto matches = MatchTopPorts(top_module, port_bits, port_name);
+            if (matches.empty() and !args.is_quiet) {
+                log_warning("Couldn't find port matching %s\n", port_name.c_str());
+            }
+            for (auto &match : matches) {
+                objects.push_back(match.first);
             }
         }
     }
-    if (objects.size() == 0 and !args.is_quiet) {
-        log_warning("Couldn't find port matching %s\n", port_name.c_str());
-    }
     return objects;
 }
@@ -27,14 +27,18 @@ puts { led[1] port}
 puts $fp {led[1] port}
 puts $fp [get_ports { led[1] }]
 
-#puts "\nsignal_* ports quiet"
-#puts $fp "signal_* ports quiet"
-#puts $fp [get_ports -quiet signal_*]
-#
-#puts "\nsignal_* ports"
-#puts $fp "signal_* ports"
-#puts $fp [get_ports signal_*]
-#
+puts "\nsignal_* ports quiet"
+puts $fp "signal_* ports quiet"
+puts $fp [get_ports -quiet signal_*]
+
+puts "\nsignal_* ports"
+puts $fp "signal_* ports"
+puts $fp [get_ports signal_*]
+
+puts "\nled\[*\] and clk ports"
+puts $fp "led\[*\] and clk ports"
+puts $fp [get_ports {led[*] clk}]
+
 #puts "\nled ports with filter expression"
 #puts $fp "led ports with filter expression"
 #puts $fp [get_ports -filter {mr_ff != true} led]
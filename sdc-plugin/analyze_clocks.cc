@@ -0,0 +1,154 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "analyze_clocks.h"
+#include "clocks.h"
+#include "disjoint_sets.h"
+#include "kernel/log.h"
+#include <cmath>
+
+USING_YOSYS_NAMESPACE
+
+void AnalyzeClocks::help()
+{
+    //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
+    log("\n");
+    log("    analyze_clocks [-threshold <window>] [-add_clock_groups]\n");
+    log("\n");
+    log("Compute the expansion window, i.e. the least common multiple of the periods,\n");
+    log("of every pair of explicit and generated clocks in the design and report the\n");
+    log("pairs whose window is longer than the threshold. Timing analysis tools have to\n");
+    log("expand the edges of such clocks over the whole window to find their closest\n");
+    log("edges, which takes long and is rarely intended for unrelated clocks.\n");
+    log("\n");
+    log("    -threshold <window>\n");
+    log("        Longest expansion window of related clocks in ns. Default: 1000.\n");
+    log("\n");
+    log("    -add_clock_groups\n");
+    log("        Add the clocks connected by windows within the threshold to clock groups\n");
+    log("        asynchronous to each other, as with set_clock_groups -asynchronous.\n");
+    log("        All asynchronous clock groups are written out as a single constraint.\n");
+    log("\n");
+}
+
+uint64_t AnalyzeClocks::ExpansionWindow(uint64_t period_a, uint64_t period_b)
+{
+    if (!period_a or !period_b) {
+        return 0;
+    }
+    uint64_t a = period_a;
+    uint64_t b = period_b;
+    while (b) {
+        uint64_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    // The window of clocks with very long coprime periods saturates
+    uint64_t window;
+    if (__builtin_mul_overflow(period_a / a, period_b, &window)) {
+        return UINT64_MAX;
+    }
+    return window;
+}
+
+void AnalyzeClocks::execute(std::vector<std::string> args, RTLIL::Design *design)
+{
+    RTLIL::Module *top_module = design->top_module();
+    if (top_module == nullptr) {
+        log_cmd_error("No top module detected\n");
+    }
+
+    float threshold = 1000;
+    bool add_clock_groups = false;
+    size_t argidx;
+    for (argidx = 1; argidx < args.size(); argidx++) {
+        std::string arg = args[argidx];
+        if (arg == "-threshold" and argidx + 1 < args.size()) {
+            try {
+                threshold = std::stof(args[++argidx]);
+            } catch (const std::invalid_argument &e) {
+                log_cmd_error("Incorrect threshold value: %s\n", args[argidx].c_str());
+            }
+            continue;
+        }
+        if (arg == "-add_clock_groups") {
+            add_clock_groups = true;
+            continue;
+        }
+        if (arg.size() > 0 and arg[0] == '-') {
+            log_cmd_error("Unknown option %s.\n", arg.c_str());
+        }
+        break;
+    }
+    if (argidx < args.size()) {
+        log_cmd_error("Command accepts no positional arguments.\n");
+    }
+
+    // Clock names with the periods in picoseconds, as written out by write_sdc
+    std::vector<std::pair<std::string, uint64_t>> clocks;
+    pool<std::string> clock_names;
+    for (auto &clock : Clocks::GetClocks(design)) {
+        auto &clock_wire = clock.second;
+        if (Clock::IsPropagated(clock_wire)) {
+            continue;
+        }
+        std::string name(Clock::Name(clock_wire));
+        if (clock_names.insert(name).second) {
+            clocks.push_back(std::make_pair(name, std::llround(Clock::Period(clock_wire) * 1000)));
+        }
+    }
+
+    // Partition the clocks into groups connected by windows within the threshold
+    DisjointSets groups(clocks.size());
+    uint64_t threshold_ps = std::llround(threshold * 1000);
+    size_t unexpandable(0);
+    log("Expansion windows of %zu clocks:\n", clocks.size());
+    for (size_t i = 0; i < clocks.size(); i++) {
+        for (size_t j = i + 1; j < clocks.size(); j++) {
+            uint64_t window = ExpansionWindow(clocks[i].second, clocks[j].second);
+            bool is_related = window <= threshold_ps;
+            log("  %s %s: %g ns%s\n", clocks[i].first.c_str(), clocks[j].first.c_str(), window / 1000.0, is_related ? "" : " (above threshold)");
+            if (is_related) {
+                groups.Union(i, j);
+            } else {
+                unexpandable++;
+            }
+        }
+    }
+    log("Found %zu clock pairs with the expansion window above %g ns\n", unexpandable, threshold);
+
+    if (!add_clock_groups or !unexpandable) {
+        return;
+    }
+    // Groups in the order of their first clocks
+    std::vector<ClockGroups::ClockGroup> clock_groups;
+    for (auto &group : groups.Sets()) {
+        clock_groups.emplace_back();
+        for (auto i : group) {
+            clock_groups.back().push_back(clocks[i].first);
+        }
+    }
+    if (clock_groups.size() < 2) {
+        log("All clocks are related through other clocks, no clock groups added\n");
+        return;
+    }
+    size_t added_count = 0;
+    for (auto &clock_group : clock_groups) {
+        added_count += sdc_writer_.AddClockGroup(design, clock_group, ClockGroups::ASYNCHRONOUS);
+    }
+    log("Added %zu asynchronous clock groups, %zu already added\n", added_count, clock_groups.size() - added_count);
+}
@@ -16,84 +16,242 @@
  *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 #include "buffers.h"
+#include "kernel/log.h"
+#include "libs/json11/json11.hpp"
 #include <cassert>
 #include <cmath>
+#include <fstream>
 
-const std::vector<std::string> Pll::inputs = {"CLKIN1", "CLKIN2"};
-const std::vector<std::string> Pll::outputs = {"CLKOUT0", "CLKOUT1", "CLKOUT2", "CLKOUT3", "CLKOUT4", "CLKOUT5"};
-const float Pll::delay = 0;
-const std::string Pll::name = "PLLE2_ADV";
+ClockBuffers::ClockBuffers()
+{
+    // Input buffers come first and buffers which can drive other buffers come before them
+    Add(Buffer(0, "IBUF", "O"));
+    Add(Buffer(0, "ckpad", "Q"));
+    Add(Buffer(0, "BUFMR", "O"));
+    Add(Buffer(0, "BUFG", "O"));
+    Add(Buffer(0, "BUFH", "O"));
+    Add(Buffer(0, "BUFIO", "O"));
+    Add(Buffer(0, "gclkbuff", "Z"));
+}
 
-Pll::Pll(RTLIL::Cell *cell, float input_clock_period, float input_clock_rising_edge) : ClockDivider({"PLLE2_ADV"})
+void ClockBuffers::Load(const std::string &json_file_name)
 {
-    assert(RTLIL::unescape_id(cell->type) == "PLLE2_ADV");
-    FetchParams(cell);
-    CheckInputClockPeriod(cell, input_clock_period);
-    CalculateOutputClockPeriods();
-    CalculateOutputClockWaveforms(input_clock_rising_edge);
+    std::ifstream json_file(json_file_name);
+    if (!json_file.good()) {
+        log_cmd_error("Can't open JSON file %s\n", json_file_name.c_str());
+    }
+    std::string json_str((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+    std::string error;
+    auto json = json11::Json::parse(json_str, error);
+    if (!error.empty()) {
+        log_cmd_error("%s\n", error.c_str());
+    }
+    for (auto &buffer : json.object_items()) {
+        auto &desc = buffer.second;
+        if (!desc["output"].is_string()) {
+            log_cmd_error("Clock buffer %s in %s needs to specify its output\n", buffer.first.c_str(), json_file_name.c_str());
+        }
+        Add(Buffer(desc["delay"].number_value(), buffer.first, desc["output"].string_value()));
+    }
 }
 
-void Pll::CheckInputClockPeriod(RTLIL::Cell *cell, float input_clock_period)
+void ClockBuffers::Add(const Buffer &buffer)
 {
-    float abs_diff = fabs(ClkinPeriod() - input_clock_period);
-    bool approx_equal = abs_diff < std::max(ClkinPeriod(), input_clock_period) * 10 * std::numeric_limits<float>::epsilon();
-    if (!approx_equal) {
-        log_cmd_error("CLKIN[1/2]_PERIOD doesn't match the virtual clock constraint "
-                      "propagated to the CLKIN[1/2] input of the clock divider cell: "
-                      "%s.\nInput clock period: %f, CLKIN[1/2]_PERIOD: %f\n",
-                      RTLIL::id2cstr(cell->name), input_clock_period, ClkinPeriod());
+    for (auto &registered : buffers_) {
+        if (registered.type == buffer.type) {
+            registered = buffer;
+            return;
+        }
     }
+    buffers_.push_back(buffer);
 }
 
-void Pll::FetchParams(RTLIL::Cell *cell)
+const Buffer *ClockBuffers::Find(const std::string &type) const
 {
-    clkin1_period = FetchParam(cell, "CLKIN1_PERIOD", 0.0);
-    clkin2_period = FetchParam(cell, "CLKIN2_PERIOD", 0.0);
-    clk_mult = FetchParam(cell, "CLKFBOUT_MULT", 5.0);
-    clk_fbout_phase = FetchParam(cell, "CLKFBOUT_PHASE", 0.0);
-    divclk_divisor = FetchParam(cell, "DIVCLK_DIVIDE", 1.0);
-    for (auto output : outputs) {
-        // CLKOUT[0-5]_DUTY_CYCLE
-        clkout_duty_cycle[output] = FetchParam(cell, output + "_DUTY_CYCLE", 0.5);
-        // CLKOUT[0-5]_DIVIDE
-        clkout_divisor[output] = FetchParam(cell, output + "_DIVIDE", 1.0);
-        // CLKOUT[0-5]_PHASE
-        clkout_phase[output] = FetchParam(cell, output + "_PHASE", 0.0);
+    for (auto &buffer : buffers_) {
+        if (buffer.type == type) {
+            return &buffer;
+        }
     }
+    return nullptr;
 }
 
-void Pll::CalculateOutputClockPeriods()
+// Create a description of a PLL or MMCM primitive
+static ClockDivider MakePll(const std::string &type, const std::vector<std::string> &inputs, const std::string &multiply, int outputs_count,
+                            const std::string &clkout0_divide)
 {
-    for (auto output : outputs) {
-        // CLKOUT[0-5]_PERIOD = CLKIN1_PERIOD * CLKOUT[0-5]_DIVIDE *
-        // DIVCLK_DIVIDE / CLKFBOUT_MULT
-        clkout_period[output] = ClkinPeriod() * clkout_divisor.at(output) / clk_mult * divclk_divisor;
+    ClockDivider divider{type, inputs, {}, {"CLKIN1_PERIOD", 0.0}, {multiply, 5.0}, {"DIVCLK_DIVIDE", 1.0}, {"CLKFBOUT_PHASE", 0.0}};
+    for (int idx = 0; idx < outputs_count; idx++) {
+        std::string output("CLKOUT" + std::to_string(idx));
+        std::string divide(idx == 0 ? clkout0_divide : output + "_DIVIDE");
+        divider.outputs.push_back(ClockDividerOutput{output, {divide, 1.0}, {output + "_PHASE", 0.0}, {output + "_DUTY_CYCLE", 0.5}});
     }
+    return divider;
+}
+
+// Create a description of a clock buffer with a divider
+static ClockDivider MakeBufferDivider(const std::string &type, const std::string &divide)
+{
+    return ClockDivider{type, {"I"}, {ClockDividerOutput{"O", {divide, 1.0}, {"", 0.0}, {"", 0.5}}}, {"", 0.0}, {"", 1.0}, {"", 1.0}, {"", 0.0}};
+}
+
+ClockDividers::ClockDividers()
+{
+    Add(MakePll("PLLE2_ADV", {"CLKIN1", "CLKIN2"}, "CLKFBOUT_MULT", 6, "CLKOUT0_DIVIDE"));
+    Add(MakePll("PLLE2_BASE", {"CLKIN1"}, "CLKFBOUT_MULT", 6, "CLKOUT0_DIVIDE"));
+    Add(MakePll("MMCME2_ADV", {"CLKIN1", "CLKIN2"}, "CLKFBOUT_MULT_F", 7, "CLKOUT0_DIVIDE_F"));
+    Add(MakePll("MMCME2_BASE", {"CLKIN1"}, "CLKFBOUT_MULT_F", 7, "CLKOUT0_DIVIDE_F"));
+    Add(MakeBufferDivider("BUFR", "BUFR_DIVIDE"));
+    Add(MakeBufferDivider("BUFGCE_DIV", "BUFGCE_DIVIDE"));
 }
 
-void Pll::CalculateOutputClockWaveforms(float input_clock_rising_edge)
+// Parse a parameter description which is either a constant value,
+// a parameter name or an object with the "name" and "default" fields
+static ClockDividerParam ParseParam(const json11::Json &json, float default_value)
 {
-    for (auto output : outputs) {
-        float output_clock_period = clkout_period.at(output);
-        clkout_rising_edge[output] =
-          fmod(input_clock_rising_edge - (clk_fbout_phase / 360.0) * ClkinPeriod() + output_clock_period * (clkout_phase[output] / 360.0),
-               output_clock_period);
-        clkout_falling_edge[output] = fmod(clkout_rising_edge[output] + clkout_duty_cycle[output] * output_clock_period, output_clock_period);
+    if (json.is_number()) {
+        return ClockDividerParam{"", static_cast<float>(json.number_value())};
     }
+    if (json.is_string()) {
+        return ClockDividerParam{json.string_value(), default_value};
+    }
+    if (json.is_object()) {
+        float value = json["default"].is_number() ? json["default"].number_value() : default_value;
+        return ClockDividerParam{json["name"].string_value(), value};
+    }
+    return ClockDividerParam{"", default_value};
 }
 
-float Pll::FetchParam(RTLIL::Cell *cell, std::string &&param_name, float default_value)
+void ClockDividers::Load(const std::string &json_file_name)
 {
-    RTLIL::IdString param(RTLIL::escape_id(param_name));
-    if (cell->hasParam(param)) {
-        auto param_obj = cell->parameters.at(param);
-        std::string value;
-        if (param_obj.flags & RTLIL::CONST_FLAG_STRING) {
-            value = param_obj.decode_string();
-        } else {
-            value = std::to_string(param_obj.as_int());
+    std::ifstream json_file(json_file_name);
+    if (!json_file.good()) {
+        log_cmd_error("Can't open JSON file %s\n", json_file_name.c_str());
+    }
+    std::string json_str((std::istreambuf_iterator<char>(json_file)), std::istreambuf_iterator<char>());
+    std::string error;
+    auto json = json11::Json::parse(json_str, error);
+    if (!error.empty()) {
+        log_cmd_error("%s\n", error.c_str());
+    }
+    for (auto &primitive : json.object_items()) {
+        auto &desc = primitive.second;
+        ClockDivider divider;
+        divider.type = primitive.first;
+        for (auto &input : desc["inputs"].array_items()) {
+            divider.inputs.push_back(input.string_value());
+        }
+        for (auto &output : desc["outputs"].array_items()) {
+            divider.outputs.push_back(ClockDividerOutput{output["port"].string_value(), ParseParam(output["divide"], 1.0),
+                                                         ParseParam(output["phase"], 0.0), ParseParam(output["duty_cycle"], 0.5)});
+        }
+        if (divider.inputs.empty() || divider.outputs.empty()) {
+            log_cmd_error("Clock divider %s in %s needs to specify its inputs and outputs\n", divider.type.c_str(), json_file_name.c_str());
+        }
+        divider.input_period = ParseParam(desc["input_period"], 0.0);
+        divider.multiply = ParseParam(desc["multiply"], 1.0);
+        divider.divide = ParseParam(desc["divide"], 1.0);
+        divider.feedback_phase = ParseParam(desc["feedback_phase"], 0.0);
+        Add(divider);
+    }
+}
+
+const ClockDivider *ClockDividers::Find(const std::string &type) const
+{
+    auto divider = dividers_.find(type);
+    if (divider == dividers_.end()) {
+        return nullptr;
+    }
+    return &divider->second;
+}
+
+Pll::Pll(const ClockDivider &divider, RTLIL::Cell *cell, float input_clock_period, float input_clock_rising_edge) : divider(divider)
+{
+    assert(RTLIL::unescape_id(cell->type) == divider.type);
+    try {
+        Rational exact_input_clock_period(Rational::FromFloat(input_clock_period));
+        FetchParams(cell, exact_input_clock_period);
+        CheckInputClockPeriod(cell, exact_input_clock_period);
+        CalculateOutputClockPeriods(cell);
+        CalculateOutputClockWaveforms(Rational::FromFloat(input_clock_rising_edge));
+    } catch (const std::overflow_error &e) {
+        log_cmd_error("Clocks of the clock divider cell %s can't be calculated: %s\n", RTLIL::id2cstr(cell->name), e.what());
+    }
+}
+
+void Pll::CheckInputClockPeriod(RTLIL::Cell *cell, const Rational &input_clock_period)
+{
+    if (ClkinPeriod().Round(1000) != input_clock_period.Round(1000)) {
+        log_cmd_error("%s doesn't match the virtual clock constraint "
+                      "propagated to the input of the clock divider cell: "
+                      "%s.\nInput clock period: %f, %s: %f\n",
+                      divider.input_period.name.c_str(), RTLIL::id2cstr(cell->name), input_clock_period.ToDouble(),
+                      divider.input_period.name.c_str(), ClkinPeriod().ToDouble());
+    }
+}
+
+void Pll::FetchParams(RTLIL::Cell *cell, const Rational &input_clock_period)
+{
+    // Use the propagated input clock if the primitive doesn't specify its period
+    clkin_period = divider.input_period.name.empty() ? input_clock_period : FetchParam(cell, divider.input_period);
+    clk_mult = FetchParam(cell, divider.multiply);
+    clk_fbout_phase = FetchParam(cell, divider.feedback_phase);
+    divclk_divisor = FetchParam(cell, divider.divide);
+    for (auto &output : divider.outputs) {
+        clkout_duty_cycle[output.port] = FetchParam(cell, output.duty_cycle);
+        clkout_divisor[output.port] = FetchParam(cell, output.divide);
+        clkout_phase[output.port] = FetchParam(cell, output.phase);
+    }
+}
+
+void Pll::CalculateOutputClockPeriods(RTLIL::Cell *cell)
+{
+    if (clk_mult == Rational(0)) {
+        log_cmd_error("%s of the clock divider cell %s is zero\n", divider.multiply.name.c_str(), RTLIL::id2cstr(cell->name));
+    }
+    for (auto &output : divider.outputs) {
+        // OUT_PERIOD = IN_PERIOD * OUT_DIVIDE * DIVIDE / MULTIPLY
+        // e.g. for PLLE2_ADV: CLKOUT[0-5]_PERIOD = CLKIN1_PERIOD * CLKOUT[0-5]_DIVIDE * DIVCLK_DIVIDE / CLKFBOUT_MULT
+        Rational period(ClkinPeriod() * clkout_divisor.at(output.port) / clk_mult * divclk_divisor);
+        if (period == Rational(0)) {
+            log_cmd_error("Output %s of the clock divider cell %s has zero period\n", output.port.c_str(), RTLIL::id2cstr(cell->name));
+        }
+        clkout_exact_period[output.port] = period;
+        clkout_period[output.port] = period.ToFloat();
+    }
+}
+
+void Pll::CalculateOutputClockWaveforms(const Rational &input_clock_rising_edge)
+{
+    const Rational full_turn(360);
+    for (auto &output : divider.outputs) {
+        const Rational &output_clock_period = clkout_exact_period.at(output.port);
+        Rational rising_edge((input_clock_rising_edge - clk_fbout_phase / full_turn * ClkinPeriod() +
+                              output_clock_period * clkout_phase.at(output.port) / full_turn)
+                               .Mod(output_clock_period));
+        Rational falling_edge((rising_edge + clkout_duty_cycle.at(output.port) * output_clock_period).Mod(output_clock_period));
+        clkout_rising_edge[output.port] = rising_edge.ToFloat();
+        clkout_falling_edge[output.port] = falling_edge.ToFloat();
+    }
+}
+
+Rational Pll::FetchParam(RTLIL::Cell *cell, const ClockDividerParam &param)
+{
+    if (param.name.empty()) {
+        return Rational::FromFloat(param.default_value);
+    }
+    RTLIL::IdString param_id(RTLIL::escape_id(param.name));
+    if (cell->hasParam(param_id)) {
+        auto param_obj = cell->parameters.at(param_id);
+        if (!(param_obj.flags & RTLIL::CONST_FLAG_STRING)) {
+            return Rational(param_obj.as_int());
+        }
+        // Non-numeric values, e.g. BUFR_DIVIDE = "BYPASS", select the default
+        try {
+            return Rational::FromFloat(std::stod(param_obj.decode_string()));
+        } catch (const std::invalid_argument &e) {
+            return Rational::FromFloat(param.default_value);
         }
-        return std::stof(value);
     }
-    return default_value;
+    return Rational::FromFloat(param.default_value);
 }
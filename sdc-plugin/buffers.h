@@ -19,6 +19,8 @@
 #define _BUFFERS_H_
 
 #include "kernel/rtlil.h"
+#include "rational.h"
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -32,59 +34,122 @@ struct Buffer {
     std::string output;
 };
 
-struct IBuf : Buffer {
-    IBuf() : Buffer(0, "IBUF", "O"){};
+// Registry of the supported clock buffer primitives. The buffers are kept
+// in the order in which the propagation passes process them.
+class ClockBuffers
+{
+  public:
+    // Create the registry with the built-in buffers which have no insertion delay
+    ClockBuffers();
+
+    // Load buffer descriptions from a JSON file. A description of an already
+    // registered buffer replaces the existing one.
+    void Load(const std::string &json_file_name);
+
+    void Add(const Buffer &buffer);
+
+    // Get the description of the buffer or nullptr if it's not registered
+    const Buffer *Find(const std::string &type) const;
+
+    const std::vector<Buffer> &Buffers() const { return buffers_; }
+
+  private:
+    std::vector<Buffer> buffers_;
+};
+
+// Parameter of a clock divider cell. If the name is empty or the cell
+// doesn't have the parameter set then the default value is used.
+struct ClockDividerParam {
+    std::string name;
+    float default_value;
 };
 
-struct Bufg : Buffer {
-    Bufg() : Buffer(0, "BUFG", "O"){};
+struct ClockDividerOutput {
+    std::string port;
+    ClockDividerParam divide;
+    ClockDividerParam phase;
+    ClockDividerParam duty_cycle;
 };
 
+// Description of a clock divider primitive (PLL, MMCM, clock buffer with
+// a divider, ...). The period and waveform of each output clock is calculated
+// from the input clock with the following formulas:
+//
+// OUT_PERIOD = IN_PERIOD * OUT_DIVIDE * DIVIDE / MULTIPLY
+// OUT_RISING_EDGE = (IN_RISING_EDGE - FEEDBACK_PHASE / 360 * IN_PERIOD + OUT_PHASE / 360 * OUT_PERIOD) mod OUT_PERIOD
+// OUT_FALLING_EDGE = (OUT_RISING_EDGE + OUT_DUTY_CYCLE * OUT_PERIOD) mod OUT_PERIOD
 struct ClockDivider {
     std::string type;
+    std::vector<std::string> inputs;
+    std::vector<ClockDividerOutput> outputs;
+    // Parameter holding the expected period of the input clock.
+    // If the name is empty the input clock period is not checked.
+    ClockDividerParam input_period;
+    ClockDividerParam multiply;
+    ClockDividerParam divide;
+    ClockDividerParam feedback_phase;
+};
+
+// Registry of the supported clock divider primitives
+class ClockDividers
+{
+  public:
+    // Create the registry with the built-in primitive descriptions
+    ClockDividers();
+
+    // Load primitive descriptions from a JSON file. A description of an
+    // already registered primitive replaces the existing one.
+    void Load(const std::string &json_file_name);
+
+    void Add(const ClockDivider &divider) { dividers_[divider.type] = divider; }
+
+    // Get the description of the primitive or nullptr if it's not registered
+    const ClockDivider *Find(const std::string &type) const;
+
+  private:
+    std::map<std::string, ClockDivider> dividers_;
 };
 
-struct Pll : public ClockDivider {
-    Pll() : ClockDivider({"PLLE2_ADV"}) {}
-    Pll(RTLIL::Cell *cell, float input_clock_period, float input_clock_rising_edge);
+// Output clocks of a clock divider cell. The periods and edges are
+// calculated with exact fractions and converted to floats only at the end,
+// so equivalent configurations produce exactly the same output clocks.
+struct Pll {
+    Pll(const ClockDivider &divider, RTLIL::Cell *cell, float input_clock_period, float input_clock_rising_edge);
 
     // Helper function to fetch a cell parameter or return a default value
-    static float FetchParam(RTLIL::Cell *cell, std::string &&param_name, float default_value);
+    static Rational FetchParam(RTLIL::Cell *cell, const ClockDividerParam &param);
 
     // Get the period of the input clock
     // TODO Add support for CLKINSEL
-    float ClkinPeriod() { return clkin1_period; }
+    const Rational &ClkinPeriod() { return clkin_period; }
 
-    static const std::vector<std::string> inputs;
-    static const std::vector<std::string> outputs;
     std::unordered_map<std::string, float> clkout_period;
-    std::unordered_map<std::string, float> clkout_duty_cycle;
     std::unordered_map<std::string, float> clkout_rising_edge;
     std::unordered_map<std::string, float> clkout_falling_edge;
 
   private:
-    // Approximate equality check of the input clock period and specified in
-    // CLKIN[1/2]_PERIOD parameter
-    void CheckInputClockPeriod(RTLIL::Cell *cell, float input_clock_period);
+    // Check that the input clock period and the one specified in the
+    // CLKIN[1/2]_PERIOD parameter are equal when rounded to picoseconds
+    void CheckInputClockPeriod(RTLIL::Cell *cell, const Rational &input_clock_period);
 
     // Fetch cell's parameters needed for further calculations
-    void FetchParams(RTLIL::Cell *cell);
+    void FetchParams(RTLIL::Cell *cell, const Rational &input_clock_period);
 
     // Calculate the period on the output clocks
-    void CalculateOutputClockPeriods();
+    void CalculateOutputClockPeriods(RTLIL::Cell *cell);
 
     // Calculate the rising and falling edges of the output clocks
-    void CalculateOutputClockWaveforms(float input_clock_rising_edge);
-
-    static const float delay;
-    static const std::string name;
-    std::unordered_map<std::string, float> clkout_divisor;
-    std::unordered_map<std::string, float> clkout_phase;
-    float clkin1_period;
-    float clkin2_period;
-    float divclk_divisor;
-    float clk_mult;
-    float clk_fbout_phase;
+    void CalculateOutputClockWaveforms(const Rational &input_clock_rising_edge);
+
+    const ClockDivider &divider;
+    std::unordered_map<std::string, Rational> clkout_divisor;
+    std::unordered_map<std::string, Rational> clkout_phase;
+    std::unordered_map<std::string, Rational> clkout_duty_cycle;
+    std::unordered_map<std::string, Rational> clkout_exact_period;
+    Rational clkin_period;
+    Rational divclk_divisor;
+    Rational clk_mult;
+    Rational clk_fbout_phase;
 };
 
 #endif // _BUFFERS_H_
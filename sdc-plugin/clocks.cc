@@ -20,20 +20,63 @@
 #include "propagation.h"
 #include <cassert>
 #include <cmath>
-#include <regex>
+#include <tuple>
+
+dict<unsigned int, ClockInfo> Clock::clock_info_;
+CacheStamp Clock::cache_stamp_;
+
+// SDC commands which don't modify the netlist or the clocks. The constraints
+// they add are kept up to date in the cache of SdcWriter.
+static const char *const unchanging_passes[] = {
+  "read_sdc", "write_sdc", "sdc_reset", "get_clocks", "set_false_path", "set_max_delay", "set_clock_groups", "analyze_clocks", "report_cdc"};
+
+uint64_t CacheStamp::DesignGeneration()
+{
+    uint64_t generation = 0;
+    for (auto &pass : pass_register) {
+        generation += pass.second->call_counter;
+    }
+    for (auto name : unchanging_passes) {
+        auto pass = pass_register.find(name);
+        if (pass != pass_register.end()) {
+            generation -= pass->second->call_counter;
+        }
+    }
+    return generation;
+}
+
+bool CacheStamp::Update(RTLIL::Module *module)
+{
+    bool same_module = module->hashidx_ == module_hashidx;
+    module_hashidx = module->hashidx_;
+    // The generation is computed once per command
+    if (current_pass and current_pass == pass and current_pass->call_counter == pass_calls) {
+        return same_module;
+    }
+    pass = current_pass;
+    pass_calls = current_pass ? current_pass->call_counter : 0;
+    uint64_t current_generation = DesignGeneration();
+    bool same_generation = pass and current_generation == generation;
+    generation = current_generation;
+    return same_module and same_generation;
+}
 
 void Clock::Add(const std::string &name, RTLIL::Wire *wire, float period, float rising_edge, float falling_edge, ClockType type)
 {
+    std::string source_wires(Clock::WireName(wire));
     wire->set_string_attribute(RTLIL::escape_id("CLOCK_SIGNAL"), "yes");
     wire->set_bool_attribute(RTLIL::escape_id("IS_GENERATED"), type == GENERATED);
     wire->set_bool_attribute(RTLIL::escape_id("IS_EXPLICIT"), type == EXPLICIT);
     wire->set_bool_attribute(RTLIL::escape_id("IS_PROPAGATED"), type == PROPAGATED);
     wire->set_string_attribute(RTLIL::escape_id("CLASS"), "clock");
     wire->set_string_attribute(RTLIL::escape_id("NAME"), name);
-    wire->set_string_attribute(RTLIL::escape_id("SOURCE_WIRES"), Clock::WireName(wire));
+    wire->set_string_attribute(RTLIL::escape_id("SOURCE_WIRES"), source_wires);
     wire->set_string_attribute(RTLIL::escape_id("PERIOD"), std::to_string(period));
     std::string waveform(std::to_string(rising_edge) + " " + std::to_string(falling_edge));
     wire->set_string_attribute(RTLIL::escape_id("WAVEFORM"), waveform);
+    SyncCache(wire);
+    clock_info_[wire->hashidx_] = ClockInfo{name, source_wires, period, rising_edge, falling_edge, type};
+    Clocks::Register(wire);
 }
 
 void Clock::Add(const std::string &name, std::vector<RTLIL::Wire *> wires, float period, float rising_edge, float falling_edge, ClockType type)
@@ -46,7 +89,64 @@ void Clock::Add(RTLIL::Wire *wire, float period, float rising_edge, float fallin
     Add(Clock::WireName(wire), wire, period, rising_edge, falling_edge, type);
 }
 
-float Clock::Period(RTLIL::Wire *clock_wire)
+void Clock::Merge(const std::vector<RTLIL::Wire *> &wires)
+{
+    RTLIL::Wire *source_wire = wires.front();
+    ClockInfo info = Info(source_wire);
+    std::string source_wires;
+    for (auto wire : wires) {
+        source_wires += (source_wires.empty() ? "" : " ") + WireName(wire);
+        Add(info.name, wire, info.period, info.rising_edge, info.falling_edge, wire == source_wire ? info.type : PROPAGATED);
+    }
+    source_wire->set_string_attribute(RTLIL::escape_id("SOURCE_WIRES"), source_wires);
+    SyncCache(source_wire);
+    clock_info_[source_wire->hashidx_].source_wires = source_wires;
+}
+
+void Clock::SyncCache(RTLIL::Wire *wire)
+{
+    if (!cache_stamp_.Update(wire->module)) {
+        clock_info_.clear();
+    }
+}
+
+const ClockInfo &Clock::Info(RTLIL::Wire *clock_wire)
+{
+    SyncCache(clock_wire);
+    auto info = clock_info_.find(clock_wire->hashidx_);
+    if (info != clock_info_.end()) {
+        return info->second;
+    }
+    return clock_info_[clock_wire->hashidx_] = ParseInfo(clock_wire);
+}
+
+ClockInfo Clock::ParseInfo(RTLIL::Wire *clock_wire)
+{
+    ClockInfo info;
+    info.period = ParsePeriod(clock_wire);
+    std::tie(info.rising_edge, info.falling_edge) = ParseWaveform(clock_wire, info.period);
+    if (clock_wire->has_attribute(RTLIL::escape_id("NAME"))) {
+        info.name = clock_wire->get_string_attribute(RTLIL::escape_id("NAME"));
+    } else {
+        info.name = WireName(clock_wire);
+    }
+    if (clock_wire->has_attribute(RTLIL::escape_id("SOURCE_WIRES"))) {
+        info.source_wires = clock_wire->get_string_attribute(RTLIL::escape_id("SOURCE_WIRES"));
+    } else {
+        info.source_wires = info.name;
+    }
+    // Clocks specified only with RTLIL attributes are treated as explicit ones
+    if (GetClockWireBoolAttribute(clock_wire, "IS_PROPAGATED")) {
+        info.type = PROPAGATED;
+    } else if (GetClockWireBoolAttribute(clock_wire, "IS_GENERATED")) {
+        info.type = GENERATED;
+    } else {
+        info.type = EXPLICIT;
+    }
+    return info;
+}
+
+float Clock::ParsePeriod(RTLIL::Wire *clock_wire)
 {
     if (!clock_wire->has_attribute(RTLIL::escape_id("PERIOD"))) {
         log_cmd_error("PERIOD has not been specified on wire '%s'.\n", WireName(clock_wire).c_str());
@@ -64,10 +164,9 @@ float Clock::Period(RTLIL::Wire *clock_wire)
     return period;
 }
 
-std::pair<float, float> Clock::Waveform(RTLIL::Wire *clock_wire)
+std::pair<float, float> Clock::ParseWaveform(RTLIL::Wire *clock_wire, float period)
 {
     if (!clock_wire->has_attribute(RTLIL::escape_id("WAVEFORM"))) {
-        float period(Period(clock_wire));
         if (!period) {
             log_cmd_error("Neither PERIOD nor WAVEFORM has been specified for wire %s\n", WireName(clock_wire).c_str());
             return std::make_pair(0, 0);
@@ -90,17 +189,15 @@ std::pair<float, float> Clock::Waveform(RTLIL::Wire *clock_wire)
     return std::make_pair(rising_edge, falling_edge);
 }
 
-float Clock::RisingEdge(RTLIL::Wire *clock_wire) { return Waveform(clock_wire).first; }
+float Clock::Period(RTLIL::Wire *clock_wire) { return Info(clock_wire).period; }
 
-float Clock::FallingEdge(RTLIL::Wire *clock_wire) { return Waveform(clock_wire).second; }
+float Clock::RisingEdge(RTLIL::Wire *clock_wire) { return Info(clock_wire).rising_edge; }
 
-std::string Clock::Name(RTLIL::Wire *clock_wire)
-{
-    if (clock_wire->has_attribute(RTLIL::escape_id("NAME"))) {
-        return clock_wire->get_string_attribute(RTLIL::escape_id("NAME"));
-    }
-    return WireName(clock_wire);
-}
+float Clock::FallingEdge(RTLIL::Wire *clock_wire) { return Info(clock_wire).falling_edge; }
+
+std::string Clock::Name(RTLIL::Wire *clock_wire) { return Info(clock_wire).name; }
+
+Clock::ClockType Clock::Type(RTLIL::Wire *clock_wire) { return Info(clock_wire).type; }
 
 std::string Clock::WireName(RTLIL::Wire *clock_wire)
 {
@@ -110,13 +207,7 @@ std::string Clock::WireName(RTLIL::Wire *clock_wire)
     return AddEscaping(RTLIL::unescape_id(clock_wire->name));
 }
 
-std::string Clock::SourceWireName(RTLIL::Wire *clock_wire)
-{
-    if (clock_wire->has_attribute(RTLIL::escape_id("SOURCE_WIRES"))) {
-        return clock_wire->get_string_attribute(RTLIL::escape_id("SOURCE_WIRES"));
-    }
-    return Name(clock_wire);
-}
+std::string Clock::SourceWireName(RTLIL::Wire *clock_wire) { return Info(clock_wire).source_wires; }
 
 bool Clock::GetClockWireBoolAttribute(RTLIL::Wire *wire, const std::string &attribute_name)
 {
@@ -126,21 +217,59 @@ bool Clock::GetClockWireBoolAttribute(RTLIL::Wire *wire, const std::string &attr
     return false;
 }
 
+Clocks::Registry Clocks::registry_;
+
 const std::map<std::string, RTLIL::Wire *> Clocks::GetClocks(RTLIL::Design *design)
 {
     std::map<std::string, RTLIL::Wire *> clock_wires;
     RTLIL::Module *top_module = design->top_module();
-    for (auto &wire_obj : top_module->wires_) {
-        auto &wire = wire_obj.second;
-        if (wire->has_attribute(RTLIL::escape_id("CLOCK_SIGNAL"))) {
-            if (wire->get_string_attribute(RTLIL::escape_id("CLOCK_SIGNAL")) == "yes") {
-                clock_wires.insert(std::make_pair(Clock::WireName(wire), wire));
+    if (registry_.stamp.Update(top_module) && registry_.module_wires == top_module->wires_.size()) {
+        for (auto &clock : registry_.clock_wires) {
+            RTLIL::Wire *wire = top_module->wire(clock.second);
+            // A registered wire has been removed, renamed or is no longer a clock
+            if (!wire || !IsClockWire(wire)) {
+                break;
             }
+            clock_wires.insert(std::make_pair(clock.first, wire));
+        }
+        if (clock_wires.size() == registry_.clock_wires.size()) {
+            return clock_wires;
         }
+        clock_wires.clear();
+    }
+    RebuildRegistry(top_module);
+    for (auto &clock : registry_.clock_wires) {
+        clock_wires.insert(std::make_pair(clock.first, top_module->wire(clock.second)));
     }
     return clock_wires;
 }
 
+void Clocks::Register(RTLIL::Wire *wire)
+{
+    // Wires of other modules are picked up when the registry is rebuilt
+    if (wire->module && wire->module->hashidx_ == registry_.stamp.module_hashidx) {
+        registry_.clock_wires.insert(std::make_pair(Clock::WireName(wire), wire->name));
+    }
+}
+
+void Clocks::RebuildRegistry(RTLIL::Module *module)
+{
+    registry_.stamp.Update(module);
+    registry_.module_wires = module->wires_.size();
+    registry_.clock_wires.clear();
+    for (auto &wire_obj : module->wires_) {
+        auto &wire = wire_obj.second;
+        if (IsClockWire(wire)) {
+            registry_.clock_wires.insert(std::make_pair(Clock::WireName(wire), wire->name));
+        }
+    }
+}
+
+bool Clocks::IsClockWire(RTLIL::Wire *wire)
+{
+    return wire->has_attribute(RTLIL::escape_id("CLOCK_SIGNAL")) && wire->get_string_attribute(RTLIL::escape_id("CLOCK_SIGNAL")) == "yes";
+}
+
 void Clocks::UpdateAbc9DelayTarget(RTLIL::Design *design)
 {
     std::map<std::string, RTLIL::Wire *> clock_wires = Clocks::GetClocks(design);
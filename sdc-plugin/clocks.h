@@ -19,6 +19,7 @@
 #define _CLOCKS_H_
 
 #include "buffers.h"
+#include "kernel/register.h"
 #include "kernel/rtlil.h"
 #include <map>
 #include <vector>
@@ -29,6 +30,32 @@ class NaturalPropagation;
 class BufferPropagation;
 class ClockDividerPropagation;
 class Propagation;
+struct ClockInfo;
+
+// Stamp of the state of the design which a cache of the clocks, names or
+// constraints was built for. Yosys doesn't notify about changes of the
+// design, but every execution of a pass increments its call counter. The
+// design generation is the sum of the call counters of all the passes except
+// the SDC commands which don't modify the netlist or the clocks, e.g.
+// set_false_path or write_sdc. A cache stays valid as long as the top module
+// is the same and only such commands have been executed since it was built,
+// so a script of constraints doesn't rebuild the caches in every command.
+// Any other pass, e.g. rename, setattr or read_json, may change the design
+// and drops the caches. Within a command the design is changed only by the
+// command itself, which keeps the caches up to date.
+struct CacheStamp {
+    // Check if a cache built with the stamp is still valid for the module
+    // and update the stamp to the current design generation and module
+    bool Update(RTLIL::Module *module);
+
+    static uint64_t DesignGeneration();
+
+    unsigned int module_hashidx = 0;
+    uint64_t generation = 0;
+    // The command in which the generation was computed
+    const Pass *pass = nullptr;
+    int pass_calls = 0;
+};
 
 class Clock
 {
@@ -41,23 +68,75 @@ class Clock
     static void Add(const std::string &name, RTLIL::Wire *wire, float period, float rising_edge, float falling_edge, ClockType type);
     static void Add(const std::string &name, std::vector<RTLIL::Wire *> wires, float period, float rising_edge, float falling_edge, ClockType type);
     static void Add(RTLIL::Wire *wire, float period, float rising_edge, float falling_edge, ClockType type);
+    // Define the clock of the first wire on all the wires. The other wires
+    // become propagated clocks of the same name.
+    static void Merge(const std::vector<RTLIL::Wire *> &wires);
     static float Period(RTLIL::Wire *clock_wire);
     static float RisingEdge(RTLIL::Wire *clock_wire);
     static float FallingEdge(RTLIL::Wire *clock_wire);
     static std::string Name(RTLIL::Wire *clock_wire);
     static std::string WireName(RTLIL::Wire *wire);
-    static std::string AddEscaping(const std::string &name) { return std::regex_replace(name, std::regex{"\\$"}, "\\$"); }
+    static std::string AddEscaping(const std::string &name)
+    {
+        // Escape the characters which have a special meaning in SDC files (i.e. in Tcl)
+        static const char *special_chars = "$[]{}\"\\;";
+        size_t pos = name.find_first_of(special_chars);
+        if (pos == std::string::npos) {
+            return name;
+        }
+        std::string escaped;
+        escaped.reserve(name.size() + 8);
+        size_t start = 0;
+        for (; pos != std::string::npos; pos = name.find_first_of(special_chars, start)) {
+            escaped.append(name, start, pos - start);
+            escaped += '\\';
+            escaped += name[pos];
+            start = pos + 1;
+        }
+        escaped.append(name, start, std::string::npos);
+        return escaped;
+    }
     static std::string SourceWireName(RTLIL::Wire *clock_wire);
-    static bool IsPropagated(RTLIL::Wire *wire) { return GetClockWireBoolAttribute(wire, "IS_PROPAGATED"); }
+    static ClockType Type(RTLIL::Wire *clock_wire);
 
-    static bool IsGenerated(RTLIL::Wire *wire) { return GetClockWireBoolAttribute(wire, "IS_GENERATED"); }
+    static bool IsPropagated(RTLIL::Wire *wire) { return Type(wire) == PROPAGATED; }
 
-    static bool IsExplicit(RTLIL::Wire *wire) { return GetClockWireBoolAttribute(wire, "IS_EXPLICIT"); }
+    static bool IsGenerated(RTLIL::Wire *wire) { return Type(wire) == GENERATED; }
+
+    static bool IsExplicit(RTLIL::Wire *wire) { return Type(wire) == EXPLICIT; }
+
+    // Drop the clock information cached for the wires of the module. It's
+    // parsed again from the RTLIL attributes when the clocks are accessed.
+    static void ClearCache() { clock_info_.clear(); }
 
   private:
-    static std::pair<float, float> Waveform(RTLIL::Wire *clock_wire);
+    // Get the clock information of the wire. The RTLIL attributes of a wire
+    // are parsed only the first time its clock is accessed in a command.
+    static const ClockInfo &Info(RTLIL::Wire *clock_wire);
+    // Drop the cached information if it may be stale for the wire's module
+    static void SyncCache(RTLIL::Wire *wire);
+    static ClockInfo ParseInfo(RTLIL::Wire *clock_wire);
+    static float ParsePeriod(RTLIL::Wire *clock_wire);
+    static std::pair<float, float> ParseWaveform(RTLIL::Wire *clock_wire, float period);
 
     static bool GetClockWireBoolAttribute(RTLIL::Wire *wire, const std::string &attribute_name);
+
+    // Clock information of the wires of a single module indexed by the hash
+    // index of the clock wire
+    static dict<unsigned int, ClockInfo> clock_info_;
+    static CacheStamp cache_stamp_;
+};
+
+// Typed clock information kept in memory for every clock wire. The clock
+// is stored in the wire's RTLIL attributes as well when it's added, as the
+// attributes are read directly by the backends and by other passes.
+struct ClockInfo {
+    std::string name;
+    std::string source_wires;
+    float period;
+    float rising_edge;
+    float falling_edge;
+    Clock::ClockType type;
 };
 
 class Clocks
@@ -65,6 +144,27 @@ class Clocks
   public:
     static const std::map<std::string, RTLIL::Wire *> GetClocks(RTLIL::Design *design);
     static void UpdateAbc9DelayTarget(RTLIL::Design *design);
+    static bool IsClockWire(RTLIL::Wire *wire);
+
+  private:
+    friend class Clock;
+
+    // Record a wire which has just become a clock wire
+    static void Register(RTLIL::Wire *wire);
+    static void RebuildRegistry(RTLIL::Module *module);
+
+    // Clock wires of the most recently queried top module. The registry is
+    // kept up to date by Clock::Add and is rebuilt with a scan of all the
+    // module's wires when the stamp can't prove that it's up to date, i.e.
+    // after a pass which may have changed the design, or when the set of
+    // wires changes.
+    struct Registry {
+        CacheStamp stamp;
+        size_t module_wires = 0;
+        // Escaped wire name to the wire identifier
+        std::map<std::string, RTLIL::IdString> clock_wires;
+    };
+    static Registry registry_;
 };
 
 #endif // _CLOCKS_H_
@@ -0,0 +1,111 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "connectivity.h"
+
+USING_YOSYS_NAMESPACE
+
+ConnectivityIndex::ConnectivityIndex(RTLIL::Module *module) : module_(module), sigmap_(module)
+{
+    for (auto cell : module->cells()) {
+        for (auto &conn : cell->connections()) {
+            if (!cell->input(conn.first)) {
+                continue;
+            }
+            for (auto bit : sigmap_(conn.second)) {
+                if (bit.wire) {
+                    sinks_[bit].push_back(CellPort{cell, conn.first});
+                }
+            }
+        }
+    }
+    for (auto wire : module->wires()) {
+        for (auto bit : sigmap_(wire)) {
+            if (bit.wire) {
+                wires_[bit].push_back(wire);
+            }
+        }
+    }
+}
+
+std::vector<CellPort> ConnectivityIndex::Sinks(RTLIL::Wire *wire) const
+{
+    std::vector<CellPort> sinks;
+    pool<std::pair<RTLIL::Cell *, RTLIL::IdString>> visited;
+    for (auto bit : sigmap_(wire)) {
+        auto it = sinks_.find(bit);
+        if (it == sinks_.end()) {
+            continue;
+        }
+        for (auto &sink : it->second) {
+            if (visited.insert(std::make_pair(sink.cell, sink.port)).second) {
+                sinks.push_back(sink);
+            }
+        }
+    }
+    return sinks;
+}
+
+std::vector<RTLIL::Wire *> ConnectivityIndex::PortWires(RTLIL::Cell *cell, const RTLIL::IdString &port) const
+{
+    std::vector<RTLIL::Wire *> wires;
+    if (!cell->hasPort(port)) {
+        return wires;
+    }
+    for (auto &chunk : cell->getPort(port).chunks()) {
+        if (chunk.wire && std::find(wires.begin(), wires.end(), chunk.wire) == wires.end()) {
+            wires.push_back(chunk.wire);
+        }
+    }
+    return wires;
+}
+
+std::vector<RTLIL::Wire *> ConnectivityIndex::AliasWires(RTLIL::Wire *wire) const
+{
+    std::vector<RTLIL::Wire *> aliases;
+    pool<RTLIL::Wire *> visited;
+    for (auto bit : sigmap_(wire)) {
+        auto it = wires_.find(bit);
+        if (it == wires_.end()) {
+            continue;
+        }
+        for (auto alias : it->second) {
+            if (visited.insert(alias).second) {
+                aliases.push_back(alias);
+            }
+        }
+    }
+    return aliases;
+}
+
+bool ConnectivityIndex::HasSinks(RTLIL::Wire *wire) const
+{
+    for (auto bit : sigmap_(wire)) {
+        if (sinks_.count(bit)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<RTLIL::SigBit> ConnectivityIndex::PortNets(RTLIL::Cell *cell, const RTLIL::IdString &port) const
+{
+    if (!cell->hasPort(port)) {
+        return std::vector<RTLIL::SigBit>();
+    }
+    return sigmap_(cell->getPort(port)).to_sigbit_vector();
+}
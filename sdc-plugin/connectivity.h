@@ -0,0 +1,67 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _CONNECTIVITY_H_
+#define _CONNECTIVITY_H_
+
+#include "kernel/rtlil.h"
+#include "kernel/sigtools.h"
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+// Cell and the name of its port that a net is connected to
+struct CellPort {
+    RTLIL::Cell *cell;
+    RTLIL::IdString port;
+};
+
+// Driver/sink connectivity of a module built in a single pass over its cells
+// and wires. All nets are canonicalized with a SigMap so that wires which are
+// aliases of each other share their sinks.
+class ConnectivityIndex
+{
+  public:
+    ConnectivityIndex(RTLIL::Module *module);
+
+    // Cell input ports the wire is connected to
+    std::vector<CellPort> Sinks(RTLIL::Wire *wire) const;
+
+    // Wires connected to the specified port of the cell
+    std::vector<RTLIL::Wire *> PortWires(RTLIL::Cell *cell, const RTLIL::IdString &port) const;
+
+    // Wires sharing at least one net with the wire, including the wire itself
+    std::vector<RTLIL::Wire *> AliasWires(RTLIL::Wire *wire) const;
+
+    bool HasSinks(RTLIL::Wire *wire) const;
+
+    // Canonical nets of the wire bits
+    std::vector<RTLIL::SigBit> WireNets(RTLIL::Wire *wire) const { return sigmap_(wire).to_sigbit_vector(); }
+
+    // Canonical nets connected to the specified port of the cell
+    std::vector<RTLIL::SigBit> PortNets(RTLIL::Cell *cell, const RTLIL::IdString &port) const;
+
+    RTLIL::Module *module() const { return module_; }
+
+  private:
+    RTLIL::Module *module_;
+    SigMap sigmap_;
+    dict<RTLIL::SigBit, std::vector<CellPort>> sinks_;
+    dict<RTLIL::SigBit, std::vector<RTLIL::Wire *>> wires_;
+};
+
+#endif // _CONNECTIVITY_H_
@@ -0,0 +1,70 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _DISJOINT_SETS_H_
+#define _DISJOINT_SETS_H_
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+// Partition of the indices 0..size-1 into disjoint sets, used to group the
+// clocks or clock domains connected by some relation
+class DisjointSets
+{
+  public:
+    explicit DisjointSets(size_t size) : parent_(size) { std::iota(parent_.begin(), parent_.end(), 0); }
+
+    // Representative of the set containing the index
+    size_t Find(size_t index)
+    {
+        size_t root = index;
+        while (parent_[root] != root) {
+            root = parent_[root];
+        }
+        // Point the whole path at the representative
+        while (parent_[index] != root) {
+            size_t next = parent_[index];
+            parent_[index] = root;
+            index = next;
+        }
+        return root;
+    }
+
+    void Union(size_t a, size_t b) { parent_[Find(b)] = Find(a); }
+
+    // Sets of indices in the order of their smallest elements
+    std::vector<std::vector<size_t>> Sets()
+    {
+        std::vector<std::vector<size_t>> sets;
+        std::vector<size_t> set_index(parent_.size(), parent_.size());
+        for (size_t index = 0; index < parent_.size(); index++) {
+            size_t root = Find(index);
+            if (set_index[root] == parent_.size()) {
+                set_index[root] = sets.size();
+                sets.emplace_back();
+            }
+            sets[set_index[root]].push_back(index);
+        }
+        return sets;
+    }
+
+  private:
+    std::vector<size_t> parent_;
+};
+
+#endif // _DISJOINT_SETS_H_
@@ -0,0 +1,232 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "name_index.h"
+#include "../common/glob_match.h"
+#include "../common/tcl_list.h"
+#include "clocks.h"
+#include <algorithm>
+#include <memory>
+#include <regex>
+
+USING_YOSYS_NAMESPACE
+
+const NameIndex &NameIndex::Get(RTLIL::Design *design)
+{
+    static std::unique_ptr<NameIndex> index;
+    if (!index or !index->stamp_.Update(design->top_module())) {
+        index.reset(new NameIndex(design));
+    }
+    return *index;
+}
+
+NameIndex::NameIndex(RTLIL::Design *design)
+{
+    RTLIL::Module *top_module = design->top_module();
+    stamp_.Update(top_module);
+    for (auto wire : top_module->wires()) {
+        AddName(RTLIL::unescape_id(wire->name));
+    }
+    for (auto cell : top_module->cells()) {
+        std::string cell_name(RTLIL::unescape_id(cell->name));
+        for (auto &conn : cell->connections()) {
+            std::string port_name(RTLIL::unescape_id(conn.first));
+            AddName(cell_name + "/" + port_name);
+            AddName(cell_name + "." + port_name);
+        }
+    }
+    for (auto &clock : Clocks::GetClocks(design)) {
+        AddName(Clock::Name(clock.second));
+    }
+    std::sort(sorted_names_.begin(), sorted_names_.end());
+}
+
+void NameIndex::AddName(const std::string &name)
+{
+    if (names_.insert(name).second) {
+        sorted_names_.push_back(name);
+    }
+}
+
+std::vector<std::string> NameIndex::Match(const std::string &pattern, bool regexp) const
+{
+    std::vector<std::string> matches;
+    if (regexp) {
+        std::regex pattern_regex;
+        try {
+            pattern_regex = std::regex(pattern);
+        } catch (const std::regex_error &e) {
+            log_cmd_error("Incorrect regular expression %s: %s\n", pattern.c_str(), e.what());
+        }
+        std::copy_if(sorted_names_.begin(), sorted_names_.end(), std::back_inserter(matches),
+                     [&pattern_regex](const std::string &name) { return std::regex_match(name, pattern_regex); });
+        return matches;
+    }
+    // Only the names starting with the part of the pattern before the first
+    // wildcard need to be checked
+    std::string prefix(pattern.substr(0, pattern.find_first_of("*?")));
+    for (auto name = std::lower_bound(sorted_names_.begin(), sorted_names_.end(), prefix);
+         name != sorted_names_.end() and name->compare(0, prefix.size(), prefix) == 0; name++) {
+        if (GlobMatch(pattern, *name)) {
+            matches.push_back(*name);
+        }
+    }
+    return matches;
+}
+
+NameFilter::NameFilter(const std::vector<std::string> &patterns, bool regexp)
+{
+    for (auto &pattern : patterns) {
+        if (regexp) {
+            try {
+                regexes_.emplace_back(pattern);
+            } catch (const std::regex_error &e) {
+                log_cmd_error("Incorrect regular expression %s: %s\n", pattern.c_str(), e.what());
+            }
+        } else if (IsGlob(pattern)) {
+            globs_.push_back(pattern);
+        } else {
+            names_.insert(pattern);
+        }
+    }
+}
+
+bool NameFilter::Matches(const std::string &name) const
+{
+    if (names_.count(name)) {
+        return true;
+    }
+    for (auto &glob : globs_) {
+        if (GlobMatch(glob, name)) {
+            return true;
+        }
+    }
+    for (auto &regex : regexes_) {
+        if (std::regex_match(name, regex)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string ResolveEndpoints(RTLIL::Design *design, const std::string &arg, bool regexp, const char *option, bool quiet)
+{
+    if (arg.empty()) {
+        return arg;
+    }
+    const NameIndex &index = NameIndex::Get(design);
+    // Only lists of several objects are split, so that single names are taken literally
+    std::vector<std::string> patterns;
+    if (arg.find_first_of(" \t\n") != std::string::npos) {
+        patterns = SplitTclList(arg);
+    } else {
+        patterns.push_back(arg);
+    }
+    std::vector<std::string> endpoints;
+    std::unordered_set<std::string> added;
+    for (auto &pattern : patterns) {
+        if (!regexp and !IsGlob(pattern)) {
+            if (!quiet and !index.Contains(pattern)) {
+                log_warning("No design object matches %s %s\n", option, pattern.c_str());
+            }
+            if (added.insert(pattern).second) {
+                endpoints.push_back(pattern);
+            }
+            continue;
+        }
+        auto matches = index.Match(pattern, regexp);
+        if (matches.empty() and !quiet) {
+            log_warning("No design object matches %s pattern %s\n", option, pattern.c_str());
+        }
+        for (auto &match : matches) {
+            if (added.insert(match).second) {
+                endpoints.push_back(match);
+            }
+        }
+    }
+    if (endpoints.size() == 1) {
+        return endpoints.front();
+    }
+    return endpoints.empty() ? std::string() : "{" + MergeTclList(endpoints) + "}";
+}
+
+std::vector<std::pair<std::string, std::string>> PairEndpointLists(RTLIL::Design *design, const std::string &from_pin,
+                                                                   const std::vector<std::string> &from_list, const std::string &to_pin,
+                                                                   const std::vector<std::string> &to_list, bool regexp, bool quiet)
+{
+    if (regexp) {
+        log_cmd_error("Option -regexp can't be combined with -from_list/-to_list\n");
+    }
+    if (!from_list.empty() and !to_list.empty() and from_list.size() != to_list.size()) {
+        log_cmd_error("Lists of start and end points have different lengths: %zu and %zu\n", from_list.size(), to_list.size());
+    }
+    if ((!from_list.empty() and !from_pin.empty()) or (!to_list.empty() and !to_pin.empty())) {
+        log_cmd_error("Options -from/-to can't be combined with -from_list/-to_list respectively\n");
+    }
+    // The elements are paired by their position, so a pattern can't be replaced by its matches
+    for (auto list : {std::make_pair(&from_list, "-from_list"), std::make_pair(&to_list, "-to_list")}) {
+        auto pattern = std::find_if(list.first->begin(), list.first->end(), IsGlob);
+        if (pattern != list.first->end()) {
+            log_cmd_error("Elements of %s need to be names, found pattern %s\n", list.second, pattern->c_str());
+        }
+    }
+    // The single point is resolved like in a single timing exception
+    std::string from_point(ResolveEndpoints(design, from_pin, false, "-from", quiet));
+    std::string to_point(ResolveEndpoints(design, to_pin, false, "-to", quiet));
+    if ((from_point.empty() and !from_pin.empty()) or (to_point.empty() and !to_pin.empty())) {
+        if (!quiet) {
+            log_warning("No design object matches the -from or -to point, no paths are added\n");
+        }
+        return {};
+    }
+    if (!quiet) {
+        ReportUnmatchedEndpoints(design, from_list, "-from");
+        ReportUnmatchedEndpoints(design, to_list, "-to");
+    }
+    std::vector<std::pair<std::string, std::string>> pairs(std::max(from_list.size(), to_list.size()), std::make_pair(from_point, to_point));
+    for (size_t idx = 0; idx < pairs.size(); idx++) {
+        if (!from_list.empty()) {
+            pairs[idx].first = from_list[idx];
+        }
+        if (!to_list.empty()) {
+            pairs[idx].second = to_list[idx];
+        }
+    }
+    return pairs;
+}
+
+void ReportUnmatchedEndpoints(RTLIL::Design *design, const std::vector<std::string> &names, const char *option)
+{
+    const NameIndex &index = NameIndex::Get(design);
+    size_t unmatched_count = 0;
+    size_t names_count = 0;
+    const std::string *first_unmatched = nullptr;
+    for (auto &name : names) {
+        if (name.empty()) {
+            continue;
+        }
+        names_count++;
+        if (!index.Contains(name)) {
+            unmatched_count++;
+            first_unmatched = first_unmatched ? first_unmatched : &name;
+        }
+    }
+    if (unmatched_count) {
+        log_warning("%zu of %zu %s points don't match any design object, e.g. %s\n", unmatched_count, names_count, option,
+                    first_unmatched->c_str());
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _NAME_INDEX_H_
+#define _NAME_INDEX_H_
+
+#include "clocks.h"
+#include "kernel/rtlil.h"
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+// Index of the names of the top module objects which can be the endpoints
+// of timing exceptions: wires, cell pins (as <cell>/<port> and <cell>.<port>)
+// and clocks.
+class NameIndex
+{
+  public:
+    // Get the index of the design's top module. The index is rebuilt only
+    // when the top module has changed or a pass which may have changed the
+    // design has been executed since it was built.
+    static const NameIndex &Get(RTLIL::Design *design);
+
+    bool Contains(const std::string &name) const { return names_.count(name); }
+
+    // Find all names matching a glob pattern with the '*' and '?' wildcards
+    // or a regular expression
+    std::vector<std::string> Match(const std::string &pattern, bool regexp) const;
+
+  private:
+    explicit NameIndex(RTLIL::Design *design);
+
+    void AddName(const std::string &name);
+
+    CacheStamp stamp_;
+    std::unordered_set<std::string> names_;
+    std::vector<std::string> sorted_names_;
+};
+
+// Filter of names given by a list of names, glob patterns or regular
+// expressions. The names are looked up in a hash set, so only the patterns
+// are checked one by one.
+class NameFilter
+{
+  public:
+    NameFilter(const std::vector<std::string> &patterns, bool regexp);
+
+    bool empty() const { return names_.empty() and globs_.empty() and regexes_.empty(); }
+
+    bool Matches(const std::string &name) const;
+
+  private:
+    pool<std::string> names_;
+    std::vector<std::string> globs_;
+    std::vector<std::regex> regexes_;
+};
+
+// Resolve the endpoint argument of a timing exception into names of design
+// objects. The argument is a name, a glob pattern, a regular expression or
+// a Tcl list of them, e.g. the result of get_pins or get_nets. The result is
+// a single name or a braced Tcl list of the names, so that a command yields
+// one constraint. Names not matching any object are kept as they are, as
+// they may refer to objects of the netlist given to other tools, patterns
+// not matching any object are dropped. Both are reported unless quiet is set.
+// An empty result for a non-empty argument means nothing has matched.
+std::string ResolveEndpoints(RTLIL::Design *design, const std::string &arg, bool regexp, const char *option, bool quiet);
+
+// Report the names from the list of endpoints which don't match any design object
+void ReportUnmatchedEndpoints(RTLIL::Design *design, const std::vector<std::string> &names, const char *option);
+
+// Pair the start and end points of the -from_list and -to_list options of the
+// timing exception commands. The lists are paired by the position of their
+// elements, a missing list is replaced by the single point of -from or -to,
+// which is resolved like by ResolveEndpoints. The elements are names of design
+// objects, hence patterns and -regexp are rejected. No pairs are returned if
+// nothing matches the single point.
+std::vector<std::pair<std::string, std::string>> PairEndpointLists(RTLIL::Design *design, const std::string &from_pin,
+                                                                   const std::vector<std::string> &from_list, const std::string &to_pin,
+                                                                   const std::vector<std::string> &to_list, bool regexp, bool quiet);
+
+#endif // _NAME_INDEX_H_
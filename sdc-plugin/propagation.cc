@@ -16,11 +16,14 @@
  *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 #include "propagation.h"
-#include <cassert>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <tuple>
 
 USING_YOSYS_NAMESPACE
 
-void Propagation::PropagateThroughBuffers(Buffer buffer)
+void Propagation::PropagateThroughBuffers(const Buffer &buffer)
 {
     for (auto &clock : Clocks::GetClocks(design_)) {
         auto &clock_wire = clock.second;
@@ -28,76 +31,82 @@ void Propagation::PropagateThroughBuffers(Buffer buffer)
         log("Clock wire %s\n", Clock::WireName(clock_wire).c_str());
 #endif
         auto buf_wires = FindSinkWiresForCellType(clock_wire, buffer.type, buffer.output);
-        int path_delay(0);
-        for (auto wire : buf_wires) {
+        for (auto &buf_wire : buf_wires) {
+            auto wire = buf_wire.first;
 #ifdef SDC_DEBUG
             log("%s wire: %s\n", buffer.type.c_str(), RTLIL::id2cstr(wire->name));
 #endif
-            path_delay += buffer.delay;
+            float path_delay = buf_wire.second * buffer.delay;
             Clock::Add(wire, Clock::Period(clock_wire), Clock::RisingEdge(clock_wire) + path_delay, Clock::FallingEdge(clock_wire) + path_delay,
                        Clock::PROPAGATED);
         }
     }
 }
 
-std::vector<RTLIL::Wire *> Propagation::FindSinkWiresForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type, const std::string &cell_port)
+std::vector<std::pair<RTLIL::Wire *, int>> Propagation::FindSinkWiresForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type,
+                                                                                 const std::string &cell_port)
 {
-    std::vector<RTLIL::Wire *> wires;
+    std::vector<std::pair<RTLIL::Wire *, int>> wires;
     if (!driver_wire) {
         return wires;
     }
-    auto cell = FindSinkCellOfType(driver_wire, cell_type);
-    RTLIL::Wire *wire = FindSinkWireOnPort(cell, cell_port);
-    if (wire) {
-        wires.push_back(wire);
-        auto further_wires = FindSinkWiresForCellType(wire, cell_type, cell_port);
-        std::copy(further_wires.begin(), further_wires.end(), std::back_inserter(wires));
+    // Breadth-first traversal of the buffer tree rooted at the driver wire.
+    // Every wire is visited at most once, so reconvergent paths and loops
+    // don't cause repeated work.
+    pool<RTLIL::Wire *> visited;
+    std::deque<std::pair<RTLIL::Wire *, int>> worklist;
+    visited.insert(driver_wire);
+    worklist.emplace_back(driver_wire, 0);
+    while (!worklist.empty()) {
+        auto current = worklist.front();
+        worklist.pop_front();
+        for (auto cell : FindSinkCellsOfType(current.first, cell_type)) {
+            for (auto wire : FindSinkWiresOnPort(cell, cell_port)) {
+                if (!visited.insert(wire).second) {
+                    continue;
+                }
+                wires.emplace_back(wire, current.second + 1);
+                worklist.emplace_back(wire, current.second + 1);
+            }
+        }
     }
     return wires;
 }
 
-RTLIL::Cell *Propagation::FindSinkCellOfType(RTLIL::Wire *wire, const std::string &type)
+std::vector<RTLIL::Cell *> Propagation::FindSinkCellsOfType(RTLIL::Wire *wire, const std::string &type)
 {
-    RTLIL::Cell *sink_cell = NULL;
+    std::vector<RTLIL::Cell *> sink_cells;
     if (!wire) {
-        return sink_cell;
+        return sink_cells;
     }
-    RTLIL::Module *top_module = design_->top_module();
-    assert(top_module);
-    std::string base_selection = top_module->name.str() + "/w:" + wire->name.str();
-    pass_->extra_args(std::vector<std::string>{base_selection, "%co:+" + type, base_selection, "%d"}, 0, design_);
-    auto selected_cells = top_module->selected_cells();
-    // FIXME Handle more than one sink
-    assert(selected_cells.size() <= 1);
-    if (selected_cells.size() > 0) {
-        sink_cell = selected_cells.at(0);
+    RTLIL::IdString type_id(RTLIL::escape_id(type));
+    for (auto &sink : index_.Sinks(wire)) {
+        if (sink.cell->type == type_id && std::find(sink_cells.begin(), sink_cells.end(), sink.cell) == sink_cells.end()) {
 #ifdef SDC_DEBUG
-        log("Found sink cell: %s\n", RTLIL::unescape_id(sink_cell->name).c_str());
+            log("Found sink cell: %s\n", RTLIL::unescape_id(sink.cell->name).c_str());
 #endif
+            sink_cells.push_back(sink.cell);
+        }
     }
-    return sink_cell;
+    return sink_cells;
 }
 
-RTLIL::Cell *Propagation::FindSinkCellOnPort(RTLIL::Wire *wire, const std::string &port)
+std::vector<RTLIL::Cell *> Propagation::FindSinkCellsOnPort(RTLIL::Wire *wire, const std::string &port)
 {
-    RTLIL::Cell *sink_cell = NULL;
+    std::vector<RTLIL::Cell *> sink_cells;
     if (!wire) {
-        return sink_cell;
+        return sink_cells;
     }
-    RTLIL::Module *top_module = design_->top_module();
-    assert(top_module);
-    std::string base_selection = top_module->name.str() + "/w:" + wire->name.str();
-    pass_->extra_args(std::vector<std::string>{base_selection, "%co:+[" + port + "]", base_selection, "%d"}, 0, design_);
-    auto selected_cells = top_module->selected_cells();
-    // FIXME Handle more than one sink
-    assert(selected_cells.size() <= 1);
-    if (selected_cells.size() > 0) {
-        sink_cell = selected_cells.at(0);
+    RTLIL::IdString port_id(RTLIL::escape_id(port));
+    for (auto &sink : index_.Sinks(wire)) {
+        if (sink.port == port_id && std::find(sink_cells.begin(), sink_cells.end(), sink.cell) == sink_cells.end()) {
 #ifdef SDC_DEBUG
-        log("Found sink cell: %s\n", RTLIL::unescape_id(sink_cell->name).c_str());
+            log("Found sink cell: %s\n", RTLIL::unescape_id(sink.cell->name).c_str());
 #endif
+            sink_cells.push_back(sink.cell);
+        }
     }
-    return sink_cell;
+    return sink_cells;
 }
 
 bool Propagation::WireHasSinkCell(RTLIL::Wire *wire)
@@ -105,34 +114,45 @@ bool Propagation::WireHasSinkCell(RTLIL::Wire *wire)
     if (!wire) {
         return false;
     }
-    RTLIL::Module *top_module = design_->top_module();
-    assert(top_module);
-    std::string base_selection = top_module->name.str() + "/w:" + wire->name.str();
-    pass_->extra_args(std::vector<std::string>{base_selection, "%co:*", base_selection, "%d"}, 0, design_);
-    auto selected_cells = top_module->selected_cells();
-    return selected_cells.size() > 0;
+    return index_.HasSinks(wire);
 }
 
-RTLIL::Wire *Propagation::FindSinkWireOnPort(RTLIL::Cell *cell, const std::string &port_name)
+std::vector<RTLIL::Wire *> Propagation::FindSinkWiresOnPort(RTLIL::Cell *cell, const std::string &port_name)
 {
-    RTLIL::Wire *sink_wire = NULL;
+    std::vector<RTLIL::Wire *> sink_wires;
     if (!cell) {
-        return sink_wire;
-    }
-    RTLIL::Module *top_module = design_->top_module();
-    assert(top_module);
-    std::string base_selection = top_module->name.str() + "/c:" + cell->name.str();
-    pass_->extra_args(std::vector<std::string>{base_selection, "%co:+[" + port_name + "]", base_selection, "%d"}, 0, design_);
-    auto selected_wires = top_module->selected_wires();
-    // FIXME Handle more than one sink
-    assert(selected_wires.size() <= 1);
-    if (selected_wires.size() > 0) {
-        sink_wire = selected_wires.at(0);
+        return sink_wires;
+    }
+    sink_wires = index_.PortWires(cell, RTLIL::escape_id(port_name));
 #ifdef SDC_DEBUG
+    for (auto sink_wire : sink_wires) {
         log("Found sink wire: %s\n", RTLIL::unescape_id(sink_wire->name).c_str());
+    }
 #endif
+    return sink_wires;
+}
+
+std::vector<std::pair<RTLIL::Cell *, const ClockDivider *>> Propagation::FindSinkClockDividers(RTLIL::Wire *wire, const ClockDividers &dividers)
+{
+    std::vector<std::pair<RTLIL::Cell *, const ClockDivider *>> cells;
+    if (!wire) {
+        return cells;
     }
-    return sink_wire;
+    for (auto &sink : index_.Sinks(wire)) {
+        auto divider = dividers.Find(RTLIL::unescape_id(sink.cell->type));
+        if (!divider) {
+            continue;
+        }
+        auto &inputs = divider->inputs;
+        if (std::find(inputs.begin(), inputs.end(), RTLIL::unescape_id(sink.port)) == inputs.end()) {
+            continue;
+        }
+        auto cell = std::make_pair(sink.cell, divider);
+        if (std::find(cells.begin(), cells.end(), cell) == cells.end()) {
+            cells.push_back(cell);
+        }
+    }
+    return cells;
 }
 
 void NaturalPropagation::Run()
@@ -154,31 +174,19 @@ void NaturalPropagation::Run()
 #endif
 }
 
-std::vector<RTLIL::Wire *> NaturalPropagation::FindAliasWires(RTLIL::Wire *wire)
-{
-    RTLIL::Module *top_module = design_->top_module();
-    assert(top_module);
-    std::vector<RTLIL::Wire *> alias_wires;
-    pass_->extra_args(std::vector<std::string>{top_module->name.str() + "/w:" + wire->name.str(), "%a"}, 0, design_);
-    for (auto module : design_->selected_modules()) {
-        for (auto wire : module->selected_wires()) {
-            alias_wires.push_back(wire);
-        }
-    }
-    return alias_wires;
-}
+std::vector<RTLIL::Wire *> NaturalPropagation::FindAliasWires(RTLIL::Wire *wire) { return index_.AliasWires(wire); }
 
 void BufferPropagation::Run()
 {
 #ifdef SDC_DEBUG
     log("Start buffer clock propagation\n");
-    log("IBUF pass\n");
 #endif
-    PropagateThroughBuffers(IBuf());
+    for (auto &buffer : buffers_.Buffers()) {
 #ifdef SDC_DEBUG
-    log("BUFG pass\n");
+        log("%s pass\n", buffer.type.c_str());
 #endif
-    PropagateThroughBuffers(Bufg());
+        PropagateThroughBuffers(buffer);
+    }
 #ifdef SDC_DEBUG
     log("Finish buffer clock propagation\n\n");
 #endif
@@ -189,49 +197,216 @@ void ClockDividerPropagation::Run()
 #ifdef SDC_DEBUG
     log("Start clock divider clock propagation\n");
 #endif
-    PropagateThroughClockDividers(Pll());
-    PropagateThroughBuffers(Bufg());
+    PropagateThroughClockDividers();
+    for (auto &buffer : buffers_.Buffers()) {
+        PropagateThroughBuffers(buffer);
+    }
 #ifdef SDC_DEBUG
     log("Finish clock divider clock propagation\n\n");
 #endif
 }
 
-void ClockDividerPropagation::PropagateThroughClockDividers(ClockDivider divider)
+void ClockDividerPropagation::PropagateThroughClockDividers()
 {
     for (auto &clock : Clocks::GetClocks(design_)) {
         auto &clock_wire = clock.second;
 #ifdef SDC_DEBUG
         log("Processing clock %s\n", Clock::WireName(clock_wire).c_str());
 #endif
-        PropagateClocksForCellType(clock_wire, divider.type);
+        PropagateClocksForDividers(clock_wire);
     }
 }
 
-void ClockDividerPropagation::PropagateClocksForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type)
+void ClockDividerPropagation::PropagateClocksForDividers(RTLIL::Wire *driver_wire)
 {
-    if (cell_type == "PLLE2_ADV") {
-        RTLIL::Cell *cell = NULL;
-        for (auto input : Pll::inputs) {
-            cell = FindSinkCellOnPort(driver_wire, input);
-            if (cell and RTLIL::unescape_id(cell->type) == cell_type) {
-                break;
+    // A clock net can feed several clock dividers, each of them is processed separately
+    for (auto &cell : FindSinkClockDividers(driver_wire, dividers_)) {
+        auto &divider = *cell.second;
+        Pll pll(divider, cell.first, Clock::Period(driver_wire), Clock::RisingEdge(driver_wire));
+        for (auto &output : divider.outputs) {
+            for (auto wire : FindSinkWiresOnPort(cell.first, output.port)) {
+                // Don't add clocks on dangling wires
+                // TODO Remove the workaround with the WireHasSinkCell check once the following issue is fixed:
+                // https://github.com/SymbiFlow/yosys-symbiflow-plugins/issues/59
+                if (WireHasSinkCell(wire)) {
+                    float clkout_period(pll.clkout_period.at(output.port));
+                    float clkout_rising_edge(pll.clkout_rising_edge.at(output.port));
+                    float clkout_falling_edge(pll.clkout_falling_edge.at(output.port));
+                    Clock::Add(wire, clkout_period, clkout_rising_edge, clkout_falling_edge, Clock::GENERATED);
+                }
             }
         }
-        if (!cell) {
-            return;
-        }
-        Pll pll(cell, Clock::Period(driver_wire), Clock::RisingEdge(driver_wire));
-        for (auto output : Pll::outputs) {
-            RTLIL::Wire *wire = FindSinkWireOnPort(cell, output);
-            // Don't add clocks on dangling wires
-            // TODO Remove the workaround with the WireHasSinkCell check once the following issue is fixed:
-            // https://github.com/SymbiFlow/yosys-symbiflow-plugins/issues/59
-            if (wire && WireHasSinkCell(wire)) {
-                float clkout_period(pll.clkout_period.at(output));
-                float clkout_rising_edge(pll.clkout_rising_edge.at(output));
-                float clkout_falling_edge(pll.clkout_falling_edge.at(output));
-                Clock::Add(wire, clkout_period, clkout_rising_edge, clkout_falling_edge, Clock::GENERATED);
+    }
+}
+
+void FixedPointPropagation::Run()
+{
+#ifdef SDC_DEBUG
+    log("Start fixed point clock propagation\n");
+#endif
+    std::vector<RTLIL::Wire *> sources;
+    for (auto &clock : Clocks::GetClocks(design_)) {
+        sources.push_back(clock.second);
+    }
+    edges_.clear();
+    clock_wires_ = pool<RTLIL::Wire *>(sources.begin(), sources.end());
+    std::vector<RTLIL::Wire *> order(TopologicalOrder(sources));
+    pool<RTLIL::Wire *> changed(sources.begin(), sources.end());
+    iterations_ = 0;
+    visited_wires_ = 0;
+    while (!changed.empty()) {
+        // Without loops in the clock network a single sweep is enough. Each
+        // further sweep is caused by a loop, so their number is bounded by
+        // the number of wires unless a loop keeps changing the clock.
+        if (iterations_ > static_cast<int>(order.size())) {
+            log_warning("Clock propagation didn't converge after %d iterations\n", iterations_);
+            break;
+        }
+        iterations_++;
+        for (auto wire : order) {
+            if (!changed.erase(wire)) {
+                continue;
+            }
+            visited_wires_++;
+#ifdef SDC_DEBUG
+            log("Processing clock wire %s\n", Clock::WireName(wire).c_str());
+#endif
+            for (auto &edge : edges_.at(wire)) {
+                if (PropagateAlongEdge(wire, edge)) {
+                    changed.insert(edge.wire);
+                }
             }
         }
     }
+#ifdef SDC_DEBUG
+    log("Finish fixed point clock propagation\n\n");
+#endif
+}
+
+std::vector<FixedPointPropagation::ClockEdge> FixedPointPropagation::FindClockEdges(RTLIL::Wire *wire)
+{
+    std::vector<ClockEdge> edges;
+    for (auto &buffer : buffers_.Buffers()) {
+        for (auto cell : FindSinkCellsOfType(wire, buffer.type)) {
+            for (auto sink_wire : FindSinkWiresOnPort(cell, buffer.output)) {
+                edges.push_back(ClockEdge{sink_wire, &buffer, cell, nullptr, buffer.output});
+            }
+        }
+    }
+    for (auto &cell : FindSinkClockDividers(wire, dividers_)) {
+        for (auto &output : cell.second->outputs) {
+            for (auto sink_wire : FindSinkWiresOnPort(cell.first, output.port)) {
+                // Don't add clocks on dangling wires
+                if (WireHasSinkCell(sink_wire)) {
+                    edges.push_back(ClockEdge{sink_wire, nullptr, cell.first, cell.second, output.port});
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+std::vector<RTLIL::Wire *> FixedPointPropagation::TopologicalOrder(const std::vector<RTLIL::Wire *> &sources)
+{
+    // Reverse post-order of an iterative depth-first search. Edges closing
+    // a loop are ignored for the ordering.
+    std::vector<RTLIL::Wire *> order;
+    pool<RTLIL::Wire *> visited;
+    for (auto source : sources) {
+        if (!visited.insert(source).second) {
+            continue;
+        }
+        edges_[source] = FindClockEdges(source);
+        std::vector<std::pair<RTLIL::Wire *, size_t>> stack{{source, 0}};
+        while (!stack.empty()) {
+            RTLIL::Wire *wire = stack.back().first;
+            size_t edge_idx = stack.back().second++;
+            auto &edges = edges_.at(wire);
+            if (edge_idx == edges.size()) {
+                order.push_back(wire);
+                stack.pop_back();
+                continue;
+            }
+            RTLIL::Wire *next = edges[edge_idx].wire;
+            if (visited.insert(next).second) {
+                edges_[next] = FindClockEdges(next);
+                stack.emplace_back(next, 0);
+            }
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+bool FixedPointPropagation::PropagateAlongEdge(RTLIL::Wire *driver_wire, const ClockEdge &edge)
+{
+    float period, rising_edge, falling_edge;
+    Clock::ClockType type;
+    if (edge.buffer) {
+        period = Clock::Period(driver_wire);
+        rising_edge = Clock::RisingEdge(driver_wire) + edge.buffer->delay;
+        falling_edge = Clock::FallingEdge(driver_wire) + edge.buffer->delay;
+        type = Clock::PROPAGATED;
+    } else {
+        Pll pll(*edge.divider, edge.cell, Clock::Period(driver_wire), Clock::RisingEdge(driver_wire));
+        period = pll.clkout_period.at(edge.port);
+        rising_edge = pll.clkout_rising_edge.at(edge.port);
+        falling_edge = pll.clkout_falling_edge.at(edge.port);
+        type = Clock::GENERATED;
+    }
+    RTLIL::Wire *wire = edge.wire;
+    if (clock_wires_.count(wire) && Clock::Period(wire) == period && Clock::RisingEdge(wire) == rising_edge &&
+        Clock::FallingEdge(wire) == falling_edge && Clock::Type(wire) == type) {
+        return false;
+    }
+    Clock::Add(wire, period, rising_edge, falling_edge, type);
+    clock_wires_.insert(wire);
+    return true;
+}
+
+void ClockMerging::Run()
+{
+#ifdef SDC_DEBUG
+    log("Start merging equivalent clocks\n");
+#endif
+    // Clock input nets of the divider, period, rising and falling edge
+    using ClockKey = std::tuple<std::vector<RTLIL::SigBit>, float, float, float>;
+    std::map<ClockKey, std::vector<RTLIL::Wire *>> equivalent_clocks;
+    pool<RTLIL::Wire *> visited;
+    merged_clocks_ = 0;
+    for (auto cell : index_.module()->cells()) {
+        auto divider = dividers_.Find(RTLIL::unescape_id(cell->type));
+        if (!divider) {
+            continue;
+        }
+        std::vector<RTLIL::SigBit> source;
+        for (auto &input : divider->inputs) {
+            auto nets = index_.PortNets(cell, RTLIL::escape_id(input));
+            source.insert(source.end(), nets.begin(), nets.end());
+        }
+        for (auto &output : divider->outputs) {
+            for (auto wire : FindSinkWiresOnPort(cell, output.port)) {
+                if (!Clocks::IsClockWire(wire) or !Clock::IsGenerated(wire) or !visited.insert(wire).second) {
+                    continue;
+                }
+                ClockKey key(source, Clock::Period(wire), Clock::RisingEdge(wire), Clock::FallingEdge(wire));
+                equivalent_clocks[key].push_back(wire);
+            }
+        }
+    }
+    for (auto &clock : equivalent_clocks) {
+        auto &wires = clock.second;
+        if (wires.size() < 2) {
+            continue;
+        }
+        std::sort(wires.begin(), wires.end(), [](RTLIL::Wire *a, RTLIL::Wire *b) { return Clock::WireName(a) < Clock::WireName(b); });
+#ifdef SDC_DEBUG
+        log("Merging %zu clocks into %s\n", wires.size(), Clock::WireName(wires.front()).c_str());
+#endif
+        Clock::Merge(wires);
+        merged_clocks_ += wires.size() - 1;
+    }
+#ifdef SDC_DEBUG
+    log("Finish merging equivalent clocks\n\n");
+#endif
 }
@@ -19,35 +19,42 @@
 #define _PROPAGATION_H_
 
 #include "clocks.h"
+#include "connectivity.h"
 
 USING_YOSYS_NAMESPACE
 
 class Propagation
 {
   public:
-    Propagation(RTLIL::Design *design, Pass *pass) : design_(design), pass_(pass) {}
+    Propagation(RTLIL::Design *design, const ConnectivityIndex &index) : design_(design), index_(index) {}
     virtual ~Propagation() {}
 
     virtual void Run() = 0;
 
   protected:
     RTLIL::Design *design_;
-    Pass *pass_;
+    const ConnectivityIndex &index_;
 
     // This propagation doesn't change the clock so the sink wire is only marked
     // as propagated clock signal, but has the properties of the driving clock
-    void PropagateThroughBuffers(Buffer buffer);
-    std::vector<RTLIL::Wire *> FindSinkWiresForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type, const std::string &cell_port);
-    RTLIL::Cell *FindSinkCellOfType(RTLIL::Wire *wire, const std::string &type);
-    RTLIL::Cell *FindSinkCellOnPort(RTLIL::Wire *wire, const std::string &port);
-    RTLIL::Wire *FindSinkWireOnPort(RTLIL::Cell *cell, const std::string &port_name);
+    void PropagateThroughBuffers(const Buffer &buffer);
+    // Find all wires driven, directly or through a chain or tree of cells of
+    // the given type, by the driver wire. Each wire is paired with the number
+    // of cells on the path from the driver wire.
+    std::vector<std::pair<RTLIL::Wire *, int>> FindSinkWiresForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type,
+                                                                        const std::string &cell_port);
+    std::vector<RTLIL::Cell *> FindSinkCellsOfType(RTLIL::Wire *wire, const std::string &type);
+    std::vector<RTLIL::Cell *> FindSinkCellsOnPort(RTLIL::Wire *wire, const std::string &port);
+    std::vector<RTLIL::Wire *> FindSinkWiresOnPort(RTLIL::Cell *cell, const std::string &port_name);
     bool WireHasSinkCell(RTLIL::Wire *wire);
+    // Find the registered clock divider cells with one of their clock inputs driven by the wire
+    std::vector<std::pair<RTLIL::Cell *, const ClockDivider *>> FindSinkClockDividers(RTLIL::Wire *wire, const ClockDividers &dividers);
 };
 
 class NaturalPropagation : public Propagation
 {
   public:
-    NaturalPropagation(RTLIL::Design *design, Pass *pass) : Propagation(design, pass) {}
+    NaturalPropagation(RTLIL::Design *design, const ConnectivityIndex &index) : Propagation(design, index) {}
 
     void Run() override;
     std::vector<RTLIL::Wire *> FindAliasWires(RTLIL::Wire *wire);
@@ -56,18 +63,101 @@ class NaturalPropagation : public Propagation
 class BufferPropagation : public Propagation
 {
   public:
-    BufferPropagation(RTLIL::Design *design, Pass *pass) : Propagation(design, pass) {}
+    BufferPropagation(RTLIL::Design *design, const ConnectivityIndex &index, const ClockBuffers &buffers)
+        : Propagation(design, index), buffers_(buffers)
+    {
+    }
 
     void Run() override;
+
+  private:
+    const ClockBuffers &buffers_;
 };
 
 class ClockDividerPropagation : public Propagation
 {
   public:
-    ClockDividerPropagation(RTLIL::Design *design, Pass *pass) : Propagation(design, pass) {}
+    ClockDividerPropagation(RTLIL::Design *design, const ConnectivityIndex &index, const ClockBuffers &buffers, const ClockDividers &dividers)
+        : Propagation(design, index), buffers_(buffers), dividers_(dividers)
+    {
+    }
 
     void Run() override;
-    void PropagateClocksForCellType(RTLIL::Wire *driver_wire, const std::string &cell_type);
-    void PropagateThroughClockDividers(ClockDivider divider);
+    // Propagate the clock through all registered clock divider cells the driver wire is connected to
+    void PropagateClocksForDividers(RTLIL::Wire *driver_wire);
+    void PropagateThroughClockDividers();
+
+  private:
+    const ClockBuffers &buffers_;
+    const ClockDividers &dividers_;
+};
+
+// Propagation through cascades of buffers and clock dividers of any depth.
+// The clock network reachable from the defined clocks is sorted
+// topologically and swept in that order. Only the wires whose clock has
+// changed are processed in the next sweep, so a loop in the clock network
+// is processed until a fixed point is reached.
+class FixedPointPropagation : public Propagation
+{
+  public:
+    FixedPointPropagation(RTLIL::Design *design, const ConnectivityIndex &index, const ClockBuffers &buffers, const ClockDividers &dividers)
+        : Propagation(design, index), buffers_(buffers), dividers_(dividers)
+    {
+    }
+
+    void Run() override;
+
+    // Number of sweeps over the clock network done by the last run
+    int Iterations() const { return iterations_; }
+
+    // Number of wires processed by the last run
+    int VisitedWires() const { return visited_wires_; }
+
+  private:
+    // Connection from a clock wire to a wire driven through a buffer or
+    // an output port of a clock divider
+    struct ClockEdge {
+        RTLIL::Wire *wire;
+        const Buffer *buffer;
+        RTLIL::Cell *cell;
+        const ClockDivider *divider;
+        std::string port;
+    };
+
+    std::vector<ClockEdge> FindClockEdges(RTLIL::Wire *wire);
+    std::vector<RTLIL::Wire *> TopologicalOrder(const std::vector<RTLIL::Wire *> &sources);
+    // Add the clock derived from the driver wire's clock on the edge's wire.
+    // Returns true if the clock on the wire has changed.
+    bool PropagateAlongEdge(RTLIL::Wire *driver_wire, const ClockEdge &edge);
+
+    const ClockBuffers &buffers_;
+    const ClockDividers &dividers_;
+    dict<RTLIL::Wire *, std::vector<ClockEdge>> edges_;
+    pool<RTLIL::Wire *> clock_wires_;
+    int iterations_ = 0;
+    int visited_wires_ = 0;
+};
+
+// Merge of equivalent generated clocks. Clocks generated by clock dividers
+// driven by the same clock net, with the same period and waveform, are
+// replaced with a single clock defined on all their wires. The wire with the
+// lowest name becomes the source of the clock and lists all the wires in its
+// SOURCE_WIRES attribute, the other wires are marked as propagated clocks.
+class ClockMerging : public Propagation
+{
+  public:
+    ClockMerging(RTLIL::Design *design, const ConnectivityIndex &index, const ClockDividers &dividers)
+        : Propagation(design, index), dividers_(dividers)
+    {
+    }
+
+    void Run() override;
+
+    // Number of clocks removed by the last run
+    int MergedClocks() const { return merged_clocks_; }
+
+  private:
+    const ClockDividers &dividers_;
+    int merged_clocks_ = 0;
 };
 #endif // PROPAGATION_H_
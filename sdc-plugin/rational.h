@@ -0,0 +1,142 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _RATIONAL_H_
+#define _RATIONAL_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+// Exact fraction used for the calculation of clock periods and edges, so
+// that equivalent clocks end up with the same values regardless of the
+// order of the operations. The values are kept reduced with a positive
+// denominator. Operations whose result doesn't fit in 64 bits throw
+// std::overflow_error instead of silently wrapping around.
+class Rational
+{
+  public:
+    Rational(int64_t numerator = 0, int64_t denominator = 1) : num_(numerator), den_(denominator) { Reduce(); }
+
+    // Convert a floating point value rounded to the resolution of the clock
+    // attributes, i.e. to six decimal places
+    static Rational FromFloat(double value)
+    {
+        double scaled = value * resolution;
+        if (!(std::fabs(scaled) < std::ldexp(1.0, 63))) {
+            throw std::overflow_error("Value out of the range of rational values");
+        }
+        return Rational(std::llround(scaled), resolution);
+    }
+
+    int64_t Numerator() const { return num_; }
+    int64_t Denominator() const { return den_; }
+
+    double ToDouble() const { return static_cast<double>(num_) / den_; }
+    float ToFloat() const { return static_cast<float>(ToDouble()); }
+
+    // Round the value multiplied by the scale to the nearest integer, with
+    // halfway cases rounded away from zero
+    int64_t Round(int64_t scale = 1) const
+    {
+        Rational scaled(*this * Rational(scale));
+        int64_t quotient = scaled.num_ / scaled.den_;
+        int64_t remainder = std::abs(scaled.num_ % scaled.den_);
+        if (remainder >= scaled.den_ - remainder) {
+            quotient += scaled.num_ < 0 ? -1 : 1;
+        }
+        return quotient;
+    }
+
+    // Remainder of the division truncated towards zero, like fmod
+    Rational Mod(const Rational &divisor) const
+    {
+        Rational quotient(*this / divisor);
+        return *this - Rational(quotient.num_ / quotient.den_) * divisor;
+    }
+
+    Rational operator+(const Rational &other) const
+    {
+        int64_t gcd = Gcd(den_, other.den_);
+        return Rational(Add(Multiply(num_, other.den_ / gcd), Multiply(other.num_, den_ / gcd)), Multiply(den_ / gcd, other.den_));
+    }
+
+    Rational operator-(const Rational &other) const { return *this + Rational(Multiply(other.num_, -1), other.den_); }
+
+    Rational operator*(const Rational &other) const
+    {
+        // Cancel the common factors first to keep the intermediate values small
+        int64_t gcd_a = Gcd(num_, other.den_);
+        int64_t gcd_b = Gcd(other.num_, den_);
+        return Rational(Multiply(num_ / gcd_a, other.num_ / gcd_b), Multiply(den_ / gcd_b, other.den_ / gcd_a));
+    }
+
+    Rational operator/(const Rational &other) const { return *this * Rational(other.den_, other.num_); }
+
+    bool operator==(const Rational &other) const { return num_ == other.num_ and den_ == other.den_; }
+    bool operator!=(const Rational &other) const { return !(*this == other); }
+
+  private:
+    static const int64_t resolution = 1000000;
+
+    static int64_t Add(int64_t a, int64_t b)
+    {
+        int64_t sum;
+        if (__builtin_add_overflow(a, b, &sum)) {
+            throw std::overflow_error("Sum of rational values out of the 64-bit range");
+        }
+        return sum;
+    }
+
+    static int64_t Multiply(int64_t a, int64_t b)
+    {
+        int64_t product;
+        if (__builtin_mul_overflow(a, b, &product)) {
+            throw std::overflow_error("Product of rational values out of the 64-bit range");
+        }
+        return product;
+    }
+
+    static int64_t Gcd(int64_t a, int64_t b)
+    {
+        a = std::abs(a);
+        b = std::abs(b);
+        while (b) {
+            int64_t remainder = a % b;
+            a = b;
+            b = remainder;
+        }
+        return a ? a : 1;
+    }
+
+    void Reduce()
+    {
+        if (den_ < 0) {
+            num_ = Multiply(num_, -1);
+            den_ = Multiply(den_, -1);
+        }
+        int64_t gcd = Gcd(num_, den_);
+        num_ /= gcd;
+        den_ /= gcd;
+    }
+
+    int64_t num_;
+    int64_t den_;
+};
+
+#endif // _RATIONAL_H_
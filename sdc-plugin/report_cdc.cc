@@ -0,0 +1,393 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "report_cdc.h"
+#include "clocks.h"
+#include "disjoint_sets.h"
+#include "kernel/log.h"
+#include "libs/json11/json11.hpp"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+
+USING_YOSYS_NAMESPACE
+
+ClockDomainCrossings::ClockDomainCrossings(RTLIL::Design *design, const ClockBuffers &buffers) : index_(design->top_module())
+{
+    AssignClockDomains(design, buffers);
+    for (auto cell : design->top_module()->cells()) {
+        for (auto &conn : cell->connections()) {
+            if (!cell->output(conn.first)) {
+                continue;
+            }
+            for (auto &bit : index_.PortNets(cell, conn.first)) {
+                if (bit.wire) {
+                    drivers_[bit] = cell;
+                }
+            }
+        }
+        RTLIL::IdString clock_port, data_port, output_port;
+        if (!GetFlipFlop(cell, clock_port, data_port, output_port)) {
+            continue;
+        }
+        int domain = -1;
+        for (auto &bit : index_.PortNets(cell, clock_port)) {
+            auto clock_net = clock_nets_.find(bit);
+            if (clock_net != clock_nets_.end()) {
+                domain = clock_net->second;
+            }
+        }
+        flip_flops_[cell] = FlipFlop{cell, data_port, output_port, domain};
+        if (domain >= 0) {
+            domains_[domain_names_.at(domain)]++;
+        }
+    }
+    FindCrossings();
+}
+
+bool ClockDomainCrossings::GetFlipFlop(RTLIL::Cell *cell, RTLIL::IdString &clock_port, RTLIL::IdString &data_port, RTLIL::IdString &output_port)
+{
+    data_port = RTLIL::escape_id("D");
+    output_port = RTLIL::escape_id("Q");
+    if (!cell->hasPort(data_port) or !cell->hasPort(output_port)) {
+        return false;
+    }
+    // Clock ports of the coarse-grain internal flip-flops ($dff, $adff, ...),
+    // the fine-grain internal ones ($_DFF_P_, ...) and the vendor ones, e.g.
+    // Xilinx FDRE or QuickLogic dffepc
+    static const char *const clock_ports[] = {"CLK", "C"};
+    for (auto port : clock_ports) {
+        if (cell->hasPort(RTLIL::escape_id(port))) {
+            clock_port = RTLIL::escape_id(port);
+            return true;
+        }
+    }
+    return false;
+}
+
+int ClockDomainCrossings::DomainIndex(const std::string &name)
+{
+    auto domain = std::find(domain_names_.begin(), domain_names_.end(), name);
+    if (domain != domain_names_.end()) {
+        return domain - domain_names_.begin();
+    }
+    domain_names_.push_back(name);
+    return domain_names_.size() - 1;
+}
+
+void ClockDomainCrossings::AssignClockDomains(RTLIL::Design *design, const ClockBuffers &buffers)
+{
+    auto clocks = Clocks::GetClocks(design);
+    // Explicit and generated clocks define the domains, which are followed
+    // through the clock buffers to the propagated clocks
+    std::deque<std::pair<RTLIL::Wire *, int>> worklist;
+    pool<RTLIL::Wire *> visited;
+    for (auto &clock : clocks) {
+        if (!Clock::IsPropagated(clock.second)) {
+            worklist.emplace_back(clock.second, DomainIndex(Clock::Name(clock.second)));
+            visited.insert(clock.second);
+        }
+    }
+    while (!worklist.empty()) {
+        auto current = worklist.front();
+        worklist.pop_front();
+        for (auto &bit : index_.WireNets(current.first)) {
+            clock_nets_.insert(std::make_pair(bit, current.second));
+        }
+        for (auto &sink : index_.Sinks(current.first)) {
+            auto buffer = buffers.Find(RTLIL::unescape_id(sink.cell->type));
+            if (!buffer) {
+                continue;
+            }
+            for (auto wire : index_.PortWires(sink.cell, RTLIL::escape_id(buffer->output))) {
+                if (visited.insert(wire).second) {
+                    worklist.emplace_back(wire, current.second);
+                }
+            }
+        }
+    }
+    // Propagated clocks not reached from any other clock form their own domains
+    for (auto &clock : clocks) {
+        if (!visited.count(clock.second)) {
+            int domain = DomainIndex(Clock::Name(clock.second));
+            for (auto &bit : index_.WireNets(clock.second)) {
+                clock_nets_.insert(std::make_pair(bit, domain));
+            }
+        }
+    }
+}
+
+const pool<int> &ClockDomainCrossings::CellDomains(RTLIL::Cell *cell)
+{
+    auto cached = cell_domains_.find(cell);
+    if (cached != cell_domains_.end()) {
+        return cached->second;
+    }
+    // Iterative depth-first traversal of the fan-in, the cells on a
+    // combinational loop see the partial result of the loop
+    pool<RTLIL::Cell *> visiting;
+    std::vector<RTLIL::Cell *> stack{cell};
+    while (!stack.empty()) {
+        RTLIL::Cell *current = stack.back();
+        if (cell_domains_.count(current)) {
+            stack.pop_back();
+            continue;
+        }
+        bool expanded = visiting.count(current);
+        visiting.insert(current);
+        pool<int> domains;
+        for (auto &conn : current->connections()) {
+            if (!current->input(conn.first)) {
+                continue;
+            }
+            for (auto &bit : index_.PortNets(current, conn.first)) {
+                auto driver = drivers_.find(bit);
+                if (driver == drivers_.end()) {
+                    continue;
+                }
+                auto flip_flop = flip_flops_.find(driver->second);
+                if (flip_flop != flip_flops_.end()) {
+                    if (flip_flop->second.domain >= 0) {
+                        domains.insert(flip_flop->second.domain);
+                    }
+                    continue;
+                }
+                auto driver_domains = cell_domains_.find(driver->second);
+                if (driver_domains != cell_domains_.end()) {
+                    domains.insert(driver_domains->second.begin(), driver_domains->second.end());
+                } else if (!expanded and !visiting.count(driver->second)) {
+                    stack.push_back(driver->second);
+                }
+            }
+        }
+        if (expanded or stack.back() == current) {
+            cell_domains_[current] = domains;
+            stack.pop_back();
+        }
+    }
+    return cell_domains_.at(cell);
+}
+
+void ClockDomainCrossings::FindCrossings()
+{
+    // Flip-flops are processed in the order of their names for a stable report
+    std::vector<FlipFlop *> flip_flops;
+    for (auto &flip_flop : flip_flops_) {
+        flip_flops.push_back(&flip_flop.second);
+    }
+    std::sort(flip_flops.begin(), flip_flops.end(), [](FlipFlop *a, FlipFlop *b) { return a->cell->name.str() < b->cell->name.str(); });
+    for (auto flip_flop : flip_flops) {
+        if (flip_flop->domain < 0) {
+            continue;
+        }
+        // Domains of the flip-flops driving the data input directly or through logic
+        pool<int> direct_domains;
+        pool<int> logic_domains;
+        for (auto &bit : index_.PortNets(flip_flop->cell, flip_flop->data_port)) {
+            auto driver = drivers_.find(bit);
+            if (driver == drivers_.end()) {
+                continue;
+            }
+            auto driver_flip_flop = flip_flops_.find(driver->second);
+            if (driver_flip_flop != flip_flops_.end()) {
+                if (driver_flip_flop->second.domain >= 0) {
+                    direct_domains.insert(driver_flip_flop->second.domain);
+                }
+                continue;
+            }
+            auto &domains = CellDomains(driver->second);
+            logic_domains.insert(domains.begin(), domains.end());
+        }
+        pool<int> foreign_domains;
+        for (auto domain : direct_domains) {
+            if (domain != flip_flop->domain) {
+                foreign_domains.insert(domain);
+            }
+        }
+        for (auto domain : logic_domains) {
+            if (domain != flip_flop->domain) {
+                foreign_domains.insert(domain);
+            }
+        }
+        if (foreign_domains.empty()) {
+            continue;
+        }
+        // The second synchronizer stage is a flip-flop of the same domain driven directly by the output
+        bool drives_own_domain = false;
+        for (auto wire : index_.PortWires(flip_flop->cell, flip_flop->output_port)) {
+            for (auto &sink : index_.Sinks(wire)) {
+                auto sink_flip_flop = flip_flops_.find(sink.cell);
+                if (sink_flip_flop != flip_flops_.end() and sink.port == sink_flip_flop->second.data_port and
+                    sink_flip_flop->second.domain == flip_flop->domain) {
+                    drives_own_domain = true;
+                }
+            }
+        }
+        std::vector<int> sorted_domains(foreign_domains.begin(), foreign_domains.end());
+        std::sort(sorted_domains.begin(), sorted_domains.end(),
+                  [this](int a, int b) { return domain_names_.at(a) < domain_names_.at(b); });
+        bool synchronized = drives_own_domain and logic_domains.empty() and direct_domains.size() == 1;
+        for (auto domain : sorted_domains) {
+            crossings_.push_back(ClockDomainCrossing{domain_names_.at(domain), domain_names_.at(flip_flop->domain), flip_flop->cell, synchronized});
+        }
+    }
+}
+
+void ReportCdc::help()
+{
+    //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
+    log("\n");
+    log("    report_cdc [-buffer_lib <file>] [-json <file>] [-add_false_paths] [-add_clock_groups]\n");
+    log("\n");
+    log("Report the data paths between flip-flops of different clock domains. The clocks\n");
+    log("need to be propagated with propagate_clocks first. The flip-flops clocked by a\n");
+    log("propagated clock belong to the domain of the clock it's buffered from.\n");
+    log("\n");
+    log("A crossing is reported as synchronized if the data input of the destination\n");
+    log("flip-flop is driven directly by a flip-flop of the source domain and its output\n");
+    log("drives the data input of another flip-flop of its own domain, i.e. it's the\n");
+    log("first stage of a two flip-flop synchronizer.\n");
+    log("\n");
+    log("    -buffer_lib <file>\n");
+    log("        Load clock buffer primitives from a JSON file, as in propagate_clocks.\n");
+    log("\n");
+    log("    -json <file>\n");
+    log("        Write the report to a JSON file.\n");
+    log("\n");
+    log("    -add_false_paths\n");
+    log("        Add a false path from the clock of the source domain to the data\n");
+    log("        input of the first stage of every synchronized crossing.\n");
+    log("\n");
+    log("    -add_clock_groups\n");
+    log("        Add the clock domains to asynchronous clock groups, so that the domains\n");
+    log("        connected by unsynchronized crossings are in the same group.\n");
+    log("\n");
+}
+
+void ReportCdc::execute(std::vector<std::string> args, RTLIL::Design *design)
+{
+    RTLIL::Module *top_module = design->top_module();
+    if (top_module == nullptr) {
+        log_cmd_error("No top module detected\n");
+    }
+
+    ClockBuffers buffers;
+    std::string json_file_name;
+    bool add_false_paths = false;
+    bool add_clock_groups = false;
+    size_t argidx;
+    for (argidx = 1; argidx < args.size(); argidx++) {
+        std::string arg = args[argidx];
+        if (arg == "-buffer_lib" and argidx + 1 < args.size()) {
+            buffers.Load(args[++argidx]);
+            continue;
+        }
+        if (arg == "-json" and argidx + 1 < args.size()) {
+            json_file_name = args[++argidx];
+            continue;
+        }
+        if (arg == "-add_false_paths") {
+            add_false_paths = true;
+            continue;
+        }
+        if (arg == "-add_clock_groups") {
+            add_clock_groups = true;
+            continue;
+        }
+        if (arg.size() > 0 and arg[0] == '-') {
+            log_cmd_error("Unknown option %s.\n", arg.c_str());
+        }
+        break;
+    }
+    if (argidx < args.size()) {
+        log_cmd_error("Command accepts no positional arguments.\n");
+    }
+
+    ClockDomainCrossings cdc(design, buffers);
+    log("Clock domains:\n");
+    for (auto &domain : cdc.Domains()) {
+        log("  %s: %d flip-flops\n", domain.first.c_str(), domain.second);
+    }
+    size_t unsynchronized(0);
+    log("Clock domain crossings:\n");
+    for (auto &crossing : cdc.Crossings()) {
+        log("  %s -> %s: %s%s\n", crossing.from_domain.c_str(), crossing.to_domain.c_str(), RTLIL::unescape_id(crossing.cell->name).c_str(),
+            crossing.synchronized ? " (synchronized)" : "");
+        unsynchronized += !crossing.synchronized;
+    }
+    log("Found %zu clock domain crossings, %zu of them unsynchronized\n", cdc.Crossings().size(), unsynchronized);
+
+    if (!json_file_name.empty()) {
+        std::ofstream json_file(json_file_name);
+        if (!json_file.good()) {
+            log_cmd_error("Can't open JSON file %s\n", json_file_name.c_str());
+        }
+        json11::Json::array crossings;
+        for (auto &crossing : cdc.Crossings()) {
+            crossings.push_back(json11::Json::object{{"from", crossing.from_domain},
+                                                     {"to", crossing.to_domain},
+                                                     {"cell", RTLIL::unescape_id(crossing.cell->name)},
+                                                     {"synchronized", crossing.synchronized}});
+        }
+        json11::Json::object domains;
+        for (auto &domain : cdc.Domains()) {
+            domains[domain.first] = domain.second;
+        }
+        json_file << json11::Json(json11::Json::object{{"domains", domains}, {"crossings", crossings}}).dump() << std::endl;
+    }
+
+    if (add_false_paths) {
+        SdcWriter::DeferredStore deferred_store(sdc_writer_, design);
+        for (auto &crossing : cdc.Crossings()) {
+            if (crossing.synchronized) {
+                std::string to_pin(RTLIL::unescape_id(crossing.cell->name) + "/D");
+                sdc_writer_.AddFalsePath(design, FalsePath{crossing.from_domain, to_pin, ""});
+            }
+        }
+    }
+
+    if (add_clock_groups) {
+        // Partition the domains into groups connected by unsynchronized crossings
+        std::vector<std::string> names;
+        for (auto &domain : cdc.Domains()) {
+            names.push_back(domain.first);
+        }
+        DisjointSets groups(names.size());
+        auto name_index = [&names](const std::string &name) { return std::lower_bound(names.begin(), names.end(), name) - names.begin(); };
+        for (auto &crossing : cdc.Crossings()) {
+            if (!crossing.synchronized) {
+                groups.Union(name_index(crossing.from_domain), name_index(crossing.to_domain));
+            }
+        }
+        std::vector<ClockGroups::ClockGroup> clock_groups;
+        for (auto &group : groups.Sets()) {
+            clock_groups.emplace_back();
+            for (auto i : group) {
+                clock_groups.back().push_back(names[i]);
+            }
+        }
+        if (clock_groups.size() < 2) {
+            log("All clock domains are connected by unsynchronized crossings, no clock groups added\n");
+            return;
+        }
+        size_t added_count = 0;
+        for (auto &clock_group : clock_groups) {
+            added_count += sdc_writer_.AddClockGroup(design, clock_group, ClockGroups::ASYNCHRONOUS);
+        }
+        log("Added %zu asynchronous clock groups, %zu already added\n", added_count, clock_groups.size() - added_count);
+    }
+}
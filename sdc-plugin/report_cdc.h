@@ -0,0 +1,92 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _REPORT_CDC_H_
+#define _REPORT_CDC_H_
+
+#include "buffers.h"
+#include "connectivity.h"
+#include "kernel/register.h"
+#include "kernel/rtlil.h"
+#include "sdc_writer.h"
+
+USING_YOSYS_NAMESPACE
+
+// Data path from a flip-flop of one clock domain to a flip-flop of another one
+struct ClockDomainCrossing {
+    std::string from_domain;
+    std::string to_domain;
+    RTLIL::Cell *cell;
+    // The destination flip-flop is the first stage of a synchronizer, i.e. its
+    // data input is driven directly by a flip-flop of the source domain and
+    // its output drives a flip-flop of its own domain
+    bool synchronized;
+};
+
+// Clock domain crossings of the top module. Each flip-flop is assigned the
+// clock domain of its clock net, where the propagated clocks belong to the
+// domain of the clock they are buffered from. The clock domains in the data
+// fan-in of the flip-flops are collected with a single memoized traversal
+// of the combinational logic.
+class ClockDomainCrossings
+{
+  public:
+    ClockDomainCrossings(RTLIL::Design *design, const ClockBuffers &buffers);
+
+    const std::vector<ClockDomainCrossing> &Crossings() const { return crossings_; }
+
+    // Number of flip-flops in each clock domain
+    const std::map<std::string, int> &Domains() const { return domains_; }
+
+  private:
+    struct FlipFlop {
+        RTLIL::Cell *cell;
+        RTLIL::IdString data_port;
+        RTLIL::IdString output_port;
+        int domain;
+    };
+
+    // Get the flip-flop description of the cell or return false if it's not a flip-flop
+    static bool GetFlipFlop(RTLIL::Cell *cell, RTLIL::IdString &clock_port, RTLIL::IdString &data_port, RTLIL::IdString &output_port);
+
+    void AssignClockDomains(RTLIL::Design *design, const ClockBuffers &buffers);
+    int DomainIndex(const std::string &name);
+    // Clock domains of the flip-flops in the fan-in of the combinational cell
+    const pool<int> &CellDomains(RTLIL::Cell *cell);
+    void FindCrossings();
+
+    ConnectivityIndex index_;
+    std::vector<std::string> domain_names_;
+    dict<RTLIL::SigBit, int> clock_nets_;
+    dict<RTLIL::SigBit, RTLIL::Cell *> drivers_;
+    dict<RTLIL::Cell *, FlipFlop> flip_flops_;
+    dict<RTLIL::Cell *, pool<int>> cell_domains_;
+    std::vector<ClockDomainCrossing> crossings_;
+    std::map<std::string, int> domains_;
+};
+
+struct ReportCdc : public Pass {
+    ReportCdc(SdcWriter &sdc_writer) : Pass("report_cdc", "Report clock domain crossings"), sdc_writer_(sdc_writer) {}
+
+    void help() override;
+
+    void execute(std::vector<std::string> args, RTLIL::Design *design) override;
+
+    SdcWriter &sdc_writer_;
+};
+
+#endif // _REPORT_CDC_H_
@@ -17,12 +17,19 @@
  */
 #include <algorithm>
 #include <array>
+#include <map>
 
+#include "../common/constraints_file.h"
+#include "../common/tcl_script_file.h"
+#include "analyze_clocks.h"
 #include "clocks.h"
 #include "kernel/log.h"
 #include "kernel/register.h"
 #include "kernel/rtlil.h"
+#include "name_index.h"
 #include "propagation.h"
+#include "report_cdc.h"
+#include "sdc_reader.h"
 #include "sdc_writer.h"
 #include "set_clock_groups.h"
 #include "set_false_path.h"
@@ -33,32 +40,89 @@ USING_YOSYS_NAMESPACE
 PRIVATE_NAMESPACE_BEGIN
 
 struct ReadSdcCmd : public Frontend {
-    ReadSdcCmd() : Frontend("sdc", "Read SDC file") {}
+    // The commands executed by the native reader
+    ReadSdcCmd(SdcWriter &sdc_writer, const std::vector<Pass *> &native_commands) : Frontend("sdc", "Read SDC file"), sdc_writer_(sdc_writer)
+    {
+        for (auto command : native_commands) {
+            native_commands_[command->pass_name] = command;
+        }
+    }
 
     void help() override
     {
         log("\n");
-        log("    read_sdc <filename>\n");
+        log("    read_sdc [-native] [-echo|-no_echo] <filename>\n");
         log("\n");
         log("Read SDC file.\n");
         log("\n");
+        log("    -echo\n");
+        log("        Write the content of the SDC file to the log.\n");
+        log("\n");
+        log("    -no_echo\n");
+        log("        Write only the size, the number of lines and the hash of the\n");
+        log("        SDC file to the log. This is the default.\n");
+        log("\n");
+        log("    -native\n");
+        log("        Execute the create_clock, set_false_path, set_max_delay and\n");
+        log("        set_clock_groups commands without the Tcl interpreter.\n");
+        log("        Files which use other commands, command substitution or\n");
+        log("        variables are evaluated by Tcl.\n");
+        log("\n");
     }
 
-    void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *) override
+    void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override
     {
         if (args.size() < 2) {
             log_cmd_error("Missing script file.\n");
         }
         log("\nReading clock constraints file(SDC)\n\n");
-        size_t argidx = 1;
+        bool native = false;
+        bool echo = false;
+        size_t argidx;
+        for (argidx = 1; argidx < args.size(); argidx++) {
+            std::string arg = args[argidx];
+            if (arg == "-native") {
+                native = true;
+                continue;
+            }
+            if (arg == "-echo") {
+                echo = true;
+                continue;
+            }
+            if (arg == "-no_echo") {
+                echo = false;
+                continue;
+            }
+            break;
+        }
         extra_args(f, filename, args, argidx);
-        std::string content{std::istreambuf_iterator<char>(*f), std::istreambuf_iterator<char>()};
-        log("%s\n", content.c_str());
+        // The file is read only once and the Tcl interpreter evaluates the content read here
+        FileDigest digest;
+        std::string content(read_constraints_file(*f, digest));
+        if (echo) {
+            log("%s\n", content.c_str());
+        } else {
+            log("Read %s: %s\n", filename.c_str(), digest.str().c_str());
+        }
+        if (native) {
+            SdcReader reader(native_commands_);
+            if (reader.Parse(content)) {
+                SdcWriter::DeferredStore deferred_store(sdc_writer_, design);
+                reader.Execute(design);
+                log("Executed %zu SDC commands without Tcl\n", reader.CommandsCount());
+                return;
+            }
+            log("Evaluating %s with Tcl: %s\n", filename.c_str(), reader.Error().c_str());
+        }
         Tcl_Interp *interp = yosys_get_tcl_interp();
-        if (Tcl_EvalFile(interp, args[argidx].c_str()) != TCL_OK) {
+        TclScriptFile script_file(interp, filename);
+        if (Tcl_EvalEx(interp, content.c_str(), content.size(), 0) != TCL_OK) {
             log_cmd_error("TCL interpreter returned an error: %s\n", Tcl_GetStringResult(interp));
         }
     }
+
+    SdcWriter &sdc_writer_;
+    std::map<std::string, Pass *> native_commands_;
 };
 
 struct WriteSdcCmd : public Backend {
@@ -99,6 +163,37 @@ struct WriteSdcCmd : public Backend {
     SdcWriter &sdc_writer_;
 };
 
+struct SdcResetCmd : public Pass {
+    SdcResetCmd(SdcWriter &sdc_writer) : Pass("sdc_reset", "Remove the timing exceptions and clock groups"), sdc_writer_(sdc_writer) {}
+
+    void help() override
+    {
+        log("\n");
+        log("    sdc_reset\n");
+        log("\n");
+        log("Remove the false paths, max delays and clock groups added to the current design\n");
+        log("and drop the clock information cached by the plugin, so that a Yosys process\n");
+        log("can be reused for an unrelated design. The clocks themselves are kept in the\n");
+        log("RTLIL attributes of the wires and are not removed.\n");
+        log("\n");
+        log("The constraints are stored in the top module, so they are not carried over\n");
+        log("to another design, e.g. after design -reset, even without this command.\n");
+        log("\n");
+    }
+
+    void execute(std::vector<std::string> args, RTLIL::Design *design) override
+    {
+        if (args.size() > 1) {
+            log_cmd_error("Command accepts no arguments.\n");
+        }
+        log("Resetting SDC constraints\n");
+        sdc_writer_.Reset(design);
+        Clock::ClearCache();
+    }
+
+    SdcWriter &sdc_writer_;
+};
+
 struct CreateClockCmd : public Pass {
     CreateClockCmd() : Pass("create_clock", "Create clock object") {}
 
@@ -197,7 +292,7 @@ struct GetClocksCmd : public Pass {
     void help() override
     {
         log("\n");
-        log("    get_clocks [-include_generated_clocks] [-of <nets>] "
+        log("    get_clocks [-include_generated_clocks] [-regexp] [-of <nets>] "
             "[<patterns>]\n");
         log("\n");
         log("Returns all clocks in the design.\n");
@@ -205,12 +300,16 @@ struct GetClocksCmd : public Pass {
         log("    -include_generated_clocks\n");
         log("        Include auto-generated clocks.\n");
         log("\n");
+        log("    -regexp\n");
+        log("        Treat the patterns and the nets as regular expressions.\n");
+        log("\n");
         log("    -of\n");
-        log("        Get clocks of these nets.\n");
+        log("        Get clocks of these nets. The nets can be glob patterns with\n");
+        log("        the '*' and '?' wildcards.\n");
         log("\n");
         log("    <pattern>\n");
-        log("        Pattern of clock names. Default are all clocks in the "
-            "design.\n");
+        log("        Pattern of clock names. Names can contain the '*' and '?'\n");
+        log("        wildcards. Default are all clocks in the design.\n");
         log("\n");
     }
 
@@ -229,6 +328,7 @@ struct GetClocksCmd : public Pass {
 
         // Parse command arguments
         bool include_generated_clocks(false);
+        bool regexp(false);
         std::vector<std::string> clocks_nets;
         size_t argidx(0);
 
@@ -239,6 +339,10 @@ struct GetClocksCmd : public Pass {
                 include_generated_clocks = true;
                 continue;
             }
+            if (arg == "-regexp") {
+                regexp = true;
+                continue;
+            }
             if (arg == "-of" and argidx + 1 < args.size()) {
                 clocks_nets = extract_list(args[++argidx]);
 #ifdef SDC_DEBUG
@@ -256,7 +360,8 @@ struct GetClocksCmd : public Pass {
         }
 
         // Parse object patterns
-        std::vector<std::string> clocks_list(args.begin() + argidx, args.end());
+        NameFilter clocks_filter(std::vector<std::string>(args.begin() + argidx, args.end()), regexp);
+        NameFilter nets_filter(clocks_nets, regexp);
 
         // Fetch clocks in the design
         std::map<std::string, RTLIL::Wire *> clocks(Clocks::GetClocks(design));
@@ -277,12 +382,12 @@ struct GetClocksCmd : public Pass {
             if (Clock::IsGenerated(clock.second) and !include_generated_clocks) {
                 continue;
             }
-            // Check if clock name is in the list of design clocks
-            if (clocks_list.size() > 0 and std::find(clocks_list.begin(), clocks_list.end(), clock.first) == clocks_list.end()) {
+            // Check if clock name matches the patterns
+            if (!clocks_filter.empty() and !clocks_filter.Matches(clock.first)) {
                 continue;
             }
-            // Check if clock wire is in the -of list
-            if (clocks_nets.size() > 0 and std::find(clocks_nets.begin(), clocks_nets.end(), Clock::WireName(clock.second)) == clocks_nets.end()) {
+            // Check if clock wire matches the -of list
+            if (!nets_filter.empty() and !nets_filter.Matches(Clock::WireName(clock.second))) {
                 continue;
             }
             auto &wire = clock.second;
@@ -300,28 +405,120 @@ struct PropagateClocksCmd : public Pass {
     void help() override
     {
         log("\n");
-        log("    propagate_clocks\n");
+        log("    propagate_clocks [-buffer_lib <file>] [-divider_lib <file>] [-fixed_point] [-merge]\n");
         log("\n");
         log("Propagate clock information throughout the design.\n");
         log("\n");
+        log("    -buffer_lib <file>\n");
+        log("        Load clock buffer primitives from a JSON file. Built-in buffers\n");
+        log("        are IBUF, BUFG, BUFH, BUFIO, BUFMR, ckpad and gclkbuff, all\n");
+        log("        with no insertion delay. Each JSON object member describes\n");
+        log("        the output port and the insertion delay of the buffer of the\n");
+        log("        same name, e.g.\n");
+        log("\n");
+        log("        {\n");
+        log("          \"BUFG\": {\"output\": \"O\", \"delay\": 0.1},\n");
+        log("          \"BUFGCE\": {\"output\": \"O\", \"delay\": 0.12}\n");
+        log("        }\n");
+        log("\n");
+        log("        The insertion delay of the buffers on the path from the clock\n");
+        log("        source shifts the waveform of the propagated clock.\n");
+        log("\n");
+        log("    -fixed_point\n");
+        log("        Propagate the clocks through cascades of clock buffer and clock\n");
+        log("        divider cells of any depth. The clock network is processed in\n");
+        log("        topological order until none of the clocks changes. The number\n");
+        log("        of iterations and visited wires is reported.\n");
+        log("\n");
+        log("    -merge\n");
+        log("        After the propagation, merge the clocks generated by clock dividers\n");
+        log("        driven by the same clock net and with the same period and waveform\n");
+        log("        into a single clock defined on all their output wires.\n");
+        log("\n");
+        log("    -divider_lib <file>\n");
+        log("        Load additional clock divider primitives from a JSON file.\n");
+        log("        Built-in primitives are PLLE2_ADV, PLLE2_BASE, MMCME2_ADV,\n");
+        log("        MMCME2_BASE, BUFR and BUFGCE_DIV. Each JSON object member\n");
+        log("        describes a primitive of the same name, e.g.\n");
+        log("\n");
+        log("        {\n");
+        log("          \"CLKDIV\": {\n");
+        log("            \"inputs\": [\"CLKIN\"],\n");
+        log("            \"input_period\": \"CLKIN_PERIOD\",\n");
+        log("            \"multiply\": {\"name\": \"MULT\", \"default\": 1},\n");
+        log("            \"divide\": 1,\n");
+        log("            \"feedback_phase\": 0,\n");
+        log("            \"outputs\": [\n");
+        log("              {\"port\": \"CLKOUT\", \"divide\": \"DIV\", \"phase\": \"PHASE\", \"duty_cycle\": 0.5}\n");
+        log("            ]\n");
+        log("          }\n");
+        log("        }\n");
+        log("\n");
+        log("        Parameters are given as a constant, a cell parameter name or\n");
+        log("        an object with the parameter name and its default value.\n");
+        log("        The output clock period is calculated as\n");
+        log("        IN_PERIOD * OUT_DIVIDE * DIVIDE / MULTIPLY. The output phase\n");
+        log("        is shifted by OUT_PHASE and the feedback phase in degrees.\n");
+        log("\n");
     }
 
     void execute(std::vector<std::string> args, RTLIL::Design *design) override
     {
-        if (args.size() > 1) {
-            log_warning("Command accepts no arguments.\nAll will be ignored.\n");
+        ClockBuffers buffers;
+        ClockDividers dividers;
+        bool fixed_point = false;
+        bool merge = false;
+        size_t argidx;
+        for (argidx = 1; argidx < args.size(); argidx++) {
+            std::string arg = args[argidx];
+            if (arg == "-buffer_lib" && argidx + 1 < args.size()) {
+                buffers.Load(args[++argidx]);
+                continue;
+            }
+            if (arg == "-divider_lib" && argidx + 1 < args.size()) {
+                dividers.Load(args[++argidx]);
+                continue;
+            }
+            if (arg == "-fixed_point") {
+                fixed_point = true;
+                continue;
+            }
+            if (arg == "-merge") {
+                merge = true;
+                continue;
+            }
+            break;
+        }
+        if (argidx < args.size()) {
+            log_warning("Command accepts no positional arguments.\nAll will be ignored.\n");
         }
         if (!design->top_module()) {
             log_cmd_error("No top module selected\n");
         }
 
-        std::array<std::unique_ptr<Propagation>, 2> passes{std::unique_ptr<Propagation>(new BufferPropagation(design, this)),
-                                                           std::unique_ptr<Propagation>(new ClockDividerPropagation(design, this))};
-
-        log("Perform clock propagation\n");
+        // Build the connectivity of the top module once and share it among all propagation passes
+        ConnectivityIndex index(design->top_module());
+        if (fixed_point) {
+            log("Perform fixed point clock propagation\n");
+            FixedPointPropagation propagation(design, index, buffers, dividers);
+            propagation.Run();
+            log("Clock propagation finished after %d iterations, %d wires visited\n", propagation.Iterations(), propagation.VisitedWires());
+        } else {
+            std::array<std::unique_ptr<Propagation>, 2> passes{
+              std::unique_ptr<Propagation>(new BufferPropagation(design, index, buffers)),
+              std::unique_ptr<Propagation>(new ClockDividerPropagation(design, index, buffers, dividers))};
+
+            log("Perform clock propagation\n");
+
+            for (auto &pass : passes) {
+                pass->Run();
+            }
+        }
 
-        for (auto &pass : passes) {
-            pass->Run();
+        if (merge) {
+            ClockMerging merging(design, index, dividers);
+            merging.Run();
+            log("Merged %d equivalent generated clocks\n", merging.MergedClocks());
         }
 
         Clocks::UpdateAbc9DelayTarget(design);
@@ -331,22 +528,31 @@ struct PropagateClocksCmd : public Pass {
 class SdcPlugin
 {
   public:
-    SdcPlugin() : write_sdc_cmd_(sdc_writer_), set_false_path_cmd_(sdc_writer_), set_max_delay_cmd_(sdc_writer_), set_clock_groups_cmd_(sdc_writer_)
+    SdcPlugin()
+        : write_sdc_cmd_(sdc_writer_), sdc_reset_cmd_(sdc_writer_), set_false_path_cmd_(sdc_writer_), set_max_delay_cmd_(sdc_writer_),
+          set_clock_groups_cmd_(sdc_writer_), analyze_clocks_cmd_(sdc_writer_), report_cdc_cmd_(sdc_writer_),
+          read_sdc_cmd_(sdc_writer_, {&create_clock_cmd_, &set_false_path_cmd_, &set_max_delay_cmd_, &set_clock_groups_cmd_})
     {
         log("Loaded SDC plugin\n");
     }
 
-    ReadSdcCmd read_sdc_cmd_;
+  private:
+    // The members are constructed in the order of their declarations, the
+    // writer is used by the commands and the commands by the SDC reader
+    SdcWriter sdc_writer_;
+
+  public:
     WriteSdcCmd write_sdc_cmd_;
+    SdcResetCmd sdc_reset_cmd_;
     CreateClockCmd create_clock_cmd_;
     GetClocksCmd get_clocks_cmd_;
     PropagateClocksCmd propagate_clocks_cmd_;
     SetFalsePath set_false_path_cmd_;
     SetMaxDelay set_max_delay_cmd_;
     SetClockGroups set_clock_groups_cmd_;
-
-  private:
-    SdcWriter sdc_writer_;
+    AnalyzeClocks analyze_clocks_cmd_;
+    ReportCdc report_cdc_cmd_;
+    ReadSdcCmd read_sdc_cmd_;
 } SdcPlugin;
 
 PRIVATE_NAMESPACE_END
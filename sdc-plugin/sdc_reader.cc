@@ -0,0 +1,263 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "sdc_reader.h"
+
+USING_YOSYS_NAMESPACE
+
+static bool IsSpace(char c) { return c == ' ' or c == '\t' or c == '\r'; }
+
+static bool IsCommandEnd(char c) { return c == '\n' or c == ';'; }
+
+bool SdcReader::Parse(const std::string &content)
+{
+    commands_.clear();
+    error_.clear();
+    line_ = 1;
+    size_t pos = 0;
+    while (pos < content.size()) {
+        std::vector<std::string> words;
+        if (!ParseCommand(content, pos, words)) {
+            commands_.clear();
+            return false;
+        }
+        if (words.empty()) {
+            continue;
+        }
+        if (!handlers_.count(words.front())) {
+            commands_.clear();
+            error_ = "unsupported command " + words.front() + " in line " + std::to_string(command_line_);
+            return false;
+        }
+        commands_.push_back(std::move(words));
+    }
+    return true;
+}
+
+void SdcReader::Execute(RTLIL::Design *design)
+{
+    for (auto &command : commands_) {
+        Pass *handler = handlers_.at(command.front());
+        // The caches of the clocks and constraints are valid within a single command
+        auto state = handler->pre_execute();
+        handler->execute(command, design);
+        handler->post_execute(state);
+    }
+}
+
+bool SdcReader::ParseCommand(const std::string &content, size_t &pos, std::vector<std::string> &words)
+{
+    while (pos < content.size()) {
+        char c = content[pos];
+        if (IsSpace(c)) {
+            pos++;
+            continue;
+        }
+        if (c == '\\' and pos + 1 < content.size() and content[pos + 1] == '\n') {
+            // Line continuation separates words
+            pos += 2;
+            line_++;
+            continue;
+        }
+        if (IsCommandEnd(c)) {
+            if (c == '\n') {
+                line_++;
+            }
+            pos++;
+            if (!words.empty()) {
+                return true;
+            }
+            continue;
+        }
+        if (c == '#' and words.empty()) {
+            // Comment, which like in Tcl can be continued with a backslash
+            while (pos < content.size() and content[pos] != '\n') {
+                if (content[pos] == '\\' and pos + 1 < content.size()) {
+                    if (content[pos + 1] == '\n') {
+                        line_++;
+                    }
+                    pos++;
+                }
+                pos++;
+            }
+            continue;
+        }
+        if (words.empty()) {
+            command_line_ = line_;
+        }
+        std::string word;
+        bool parsed;
+        if (c == '{') {
+            parsed = ParseBracedWord(content, pos, word);
+        } else if (c == '"') {
+            parsed = ParseQuotedWord(content, pos, word);
+        } else {
+            parsed = ParseBareWord(content, pos, word);
+        }
+        if (!parsed) {
+            return false;
+        }
+        words.push_back(std::move(word));
+    }
+    return true;
+}
+
+bool SdcReader::ParseBracedWord(const std::string &content, size_t &pos, std::string &word)
+{
+    // No substitutions are done inside braces apart from the line continuation
+    int depth = 1;
+    for (pos++; pos < content.size(); pos++) {
+        char c = content[pos];
+        if (c == '\\' and pos + 1 < content.size()) {
+            if (content[pos + 1] == '\n') {
+                line_++;
+                word += ' ';
+                for (pos += 2; pos < content.size() and IsSpace(content[pos]); pos++) {
+                }
+                pos--;
+            } else {
+                word += c;
+                word += content[++pos];
+            }
+            continue;
+        }
+        if (c == '\n') {
+            line_++;
+        } else if (c == '{') {
+            depth++;
+        } else if (c == '}' and --depth == 0) {
+            pos++;
+            if (pos < content.size() and !IsSpace(content[pos]) and !IsCommandEnd(content[pos]) and content[pos] != '\\') {
+                return SetError("extra characters after close-brace");
+            }
+            return true;
+        }
+        word += c;
+    }
+    return SetError("missing close-brace");
+}
+
+bool SdcReader::ParseQuotedWord(const std::string &content, size_t &pos, std::string &word)
+{
+    for (pos++; pos < content.size();) {
+        char c = content[pos];
+        if (c == '"') {
+            pos++;
+            if (pos < content.size() and !IsSpace(content[pos]) and !IsCommandEnd(content[pos]) and content[pos] != '\\') {
+                return SetError("extra characters after close-quote");
+            }
+            return true;
+        }
+        if (c == '[' or c == '$') {
+            return SetError("command or variable substitution");
+        }
+        if (c == '\\') {
+            if (!ParseBackslash(content, pos, word)) {
+                return false;
+            }
+            continue;
+        }
+        if (c == '\n') {
+            line_++;
+        }
+        word += c;
+        pos++;
+    }
+    return SetError("missing close-quote");
+}
+
+bool SdcReader::ParseBareWord(const std::string &content, size_t &pos, std::string &word)
+{
+    while (pos < content.size()) {
+        char c = content[pos];
+        if (IsSpace(c) or IsCommandEnd(c)) {
+            return true;
+        }
+        if (c == '[' or c == '$') {
+            return SetError("command or variable substitution");
+        }
+        if (c == '\\') {
+            if (pos + 1 < content.size() and content[pos + 1] == '\n') {
+                return true;
+            }
+            if (!ParseBackslash(content, pos, word)) {
+                return false;
+            }
+            continue;
+        }
+        word += c;
+        pos++;
+    }
+    return true;
+}
+
+bool SdcReader::ParseBackslash(const std::string &content, size_t &pos, std::string &word)
+{
+    pos++;
+    if (pos == content.size()) {
+        word += '\\';
+        return true;
+    }
+    char c = content[pos++];
+    switch (c) {
+    case 'a':
+        word += '\a';
+        break;
+    case 'b':
+        word += '\b';
+        break;
+    case 'f':
+        word += '\f';
+        break;
+    case 'n':
+        word += '\n';
+        break;
+    case 'r':
+        word += '\r';
+        break;
+    case 't':
+        word += '\t';
+        break;
+    case 'v':
+        word += '\v';
+        break;
+    case 'x':
+    case 'u':
+    case 'U':
+        return SetError("unsupported backslash substitution");
+    case '\n':
+        line_++;
+        word += ' ';
+        while (pos < content.size() and IsSpace(content[pos])) {
+            pos++;
+        }
+        break;
+    default:
+        if (c >= '0' and c <= '7') {
+            return SetError("unsupported backslash substitution");
+        }
+        word += c;
+        break;
+    }
+    return true;
+}
+
+bool SdcReader::SetError(const std::string &message)
+{
+    error_ = message + " in line " + std::to_string(line_);
+    return false;
+}
@@ -0,0 +1,69 @@
+/*
+ *  yosys -- Yosys Open SYnthesis Suite
+ *
+ *  Copyright (C) 2020  The Symbiflow Authors
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any
+ *  purpose with or without fee is hereby granted, provided that the above
+ *  copyright notice and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ *  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ *  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ *  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ *  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ *  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#ifndef _SDC_READER_H_
+#define _SDC_READER_H_
+
+#include "kernel/register.h"
+#include "kernel/rtlil.h"
+#include <map>
+#include <string>
+#include <vector>
+
+USING_YOSYS_NAMESPACE
+
+// Reader of SDC files which executes the supported subset of SDC commands
+// without evaluating them in the Tcl interpreter. Words are split according
+// to the Tcl rules: brace and double quote grouping, backslash substitution
+// and line continuation, comments and ';' command separators are supported.
+// Files which use command or variable substitution or commands outside of the
+// supported subset need to be evaluated by Tcl.
+class SdcReader
+{
+  public:
+    // The handlers of the supported commands indexed by the command name
+    explicit SdcReader(const std::map<std::string, Pass *> &handlers) : handlers_(handlers) {}
+
+    // Split the content of an SDC file into commands. Returns false if the
+    // file needs to be evaluated by Tcl, the reason is given by Error().
+    bool Parse(const std::string &content);
+
+    // Execute the parsed commands with the command handlers. The handlers
+    // are called directly, without looking them up by name like Pass::call,
+    // but with the same bookkeeping of the current command.
+    void Execute(RTLIL::Design *design);
+
+    const std::string &Error() const { return error_; }
+
+    size_t CommandsCount() const { return commands_.size(); }
+
+  private:
+    bool ParseCommand(const std::string &content, size_t &pos, std::vector<std::string> &words);
+    bool ParseBracedWord(const std::string &content, size_t &pos, std::string &word);
+    bool ParseQuotedWord(const std::string &content, size_t &pos, std::string &word);
+    bool ParseBareWord(const std::string &content, size_t &pos, std::string &word);
+    bool ParseBackslash(const std::string &content, size_t &pos, std::string &word);
+    bool SetError(const std::string &message);
+
+    const std::map<std::string, Pass *> &handlers_;
+    std::vector<std::vector<std::string>> commands_;
+    std::string error_;
+    size_t line_;
+    size_t command_line_;
+};
+
+#endif // _SDC_READER_H_
@@ -16,27 +16,240 @@
  *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 #include "sdc_writer.h"
+#include "../common/tcl_list.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 
 USING_YOSYS_NAMESPACE
 
+// Size of the blocks in which the SDC file is written out
+static const size_t write_block_size = 64 * 1024;
+
 const std::map<ClockGroups::ClockGroupRelation, std::string> ClockGroups::relation_name_map = {
   {NONE, ""}, {ASYNCHRONOUS, "asynchronous"}, {PHYSICALLY_EXCLUSIVE, "physically_exclusive"}, {LOGICALLY_EXCLUSIVE, "logically_exclusive"}};
 
-void SdcWriter::AddFalsePath(FalsePath false_path) { false_paths_.push_back(false_path); }
+static size_t CombineHash(size_t seed, size_t hash) { return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2)); }
 
-void SdcWriter::SetMaxDelay(TimingPath timing_path) { timing_paths_.push_back(timing_path); }
+size_t FalsePathHash::operator()(const FalsePath &path) const
+{
+    std::hash<std::string> string_hash;
+    size_t hash = string_hash(path.from_pin);
+    hash = CombineHash(hash, string_hash(path.through_pin));
+    return CombineHash(hash, string_hash(path.to_pin));
+}
 
-void SdcWriter::AddClockGroup(ClockGroups::ClockGroup clock_group, ClockGroups::ClockGroupRelation relation)
+size_t TimingPathHash::operator()(const TimingPath &path) const
 {
-    clock_groups_.Add(clock_group, relation);
+    std::hash<std::string> string_hash;
+    size_t hash = string_hash(path.from_pin);
+    hash = CombineHash(hash, string_hash(path.to_pin));
+    return CombineHash(hash, std::hash<float>()(path.max_delay));
+}
+
+// Maximum number of constraints stored in a single attribute
+static const size_t constraints_per_chunk = 1024;
+
+static std::string FormatFloat(float value)
+{
+    // Enough digits to read back the same float value
+    char formatted[32];
+    std::snprintf(formatted, sizeof(formatted), "%.9g", value);
+    return formatted;
+}
+
+bool SdcWriter::AddFalsePath(RTLIL::Design *design, const FalsePath &false_path)
+{
+    Sync(design);
+    if (!false_paths_.Add(false_path)) {
+        return false;
+    }
+    Append(design, false_paths_list_, {false_path.from_pin, false_path.through_pin, false_path.to_pin});
+    return true;
+}
+
+bool SdcWriter::SetMaxDelay(RTLIL::Design *design, const TimingPath &timing_path)
+{
+    Sync(design);
+    if (!timing_paths_.Add(timing_path)) {
+        return false;
+    }
+    Append(design, max_delays_list_, {timing_path.from_pin, timing_path.to_pin, FormatFloat(timing_path.max_delay)});
+    return true;
+}
+
+bool SdcWriter::AddClockGroup(RTLIL::Design *design, const ClockGroups::ClockGroup &clock_group, ClockGroups::ClockGroupRelation relation)
+{
+    Sync(design);
+    if (!clock_groups_.Add(clock_group, relation)) {
+        return false;
+    }
+    Append(design, clock_groups_list_, {ClockGroups::relation_name_map.at(relation), MergeTclList(clock_group)});
+    return true;
+}
+
+std::string SdcWriter::StoredList::ChunkName(size_t index) const { return RTLIL::escape_id(attribute) + "_" + std::to_string(index); }
+
+void SdcWriter::StoredList::clear()
+{
+    chunks = 0;
+    last_chunk.clear();
+    last_chunk_size = 0;
+    changed = false;
+}
+
+// Find the attributes of the module storing the chunks of the list of
+// constraints and order them by their index
+static std::map<size_t, RTLIL::IdString> FindChunks(RTLIL::Module *module, const char *attribute)
+{
+    std::string prefix(RTLIL::escape_id(attribute) + "_");
+    std::map<size_t, RTLIL::IdString> chunks;
+    for (auto &attr : module->attributes) {
+        const std::string &name = attr.first.str();
+        if (name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        std::string index(name.substr(prefix.size()));
+        if (index.empty() or index.size() > 9 or index.find_first_not_of("0123456789") != std::string::npos) {
+            log_warning("Attribute %s of module %s isn't a chunk of the SDC constraints, ignoring it\n", RTLIL::unescape_id(name).c_str(),
+                        RTLIL::unescape_id(module->name).c_str());
+            continue;
+        }
+        chunks.emplace(std::stoul(index), attr.first);
+    }
+    return chunks;
+}
+
+void SdcWriter::Append(RTLIL::Design *design, StoredList &list, const std::vector<std::string> &fields)
+{
+    RTLIL::Module *top_module = design->top_module();
+    if (list.chunks == 0 or list.last_chunk_size >= constraints_per_chunk) {
+        // The full chunk is stored before the next one is started
+        StoreLastChunk(top_module, list);
+        list.last_chunk.clear();
+        list.last_chunk_size = 0;
+        list.chunks++;
+    }
+    if (!list.last_chunk.empty()) {
+        list.last_chunk += ' ';
+    }
+    list.last_chunk += MergeTclList({MergeTclList(fields)});
+    list.last_chunk_size++;
+    list.changed = true;
+    if (!deferred_stores_) {
+        StoreLastChunk(top_module, list);
+    }
+}
+
+void SdcWriter::Store(RTLIL::Design *design)
+{
+    RTLIL::Module *top_module = design->top_module();
+    for (auto list : {&false_paths_list_, &max_delays_list_, &clock_groups_list_}) {
+        StoreLastChunk(top_module, *list);
+    }
+}
+
+void SdcWriter::StoreLastChunk(RTLIL::Module *module, StoredList &list)
+{
+    if (!list.changed or !module) {
+        return;
+    }
+    module->set_string_attribute(list.ChunkName(list.chunks - 1), list.last_chunk);
+    list.changed = false;
+}
+
+void SdcWriter::Sync(RTLIL::Design *design)
+{
+    RTLIL::Module *top_module = design->top_module();
+    if (!top_module) {
+        log_cmd_error("The SDC constraints are stored in the top module but the design has no top module\n");
+    }
+    // Between the SDC commands the attributes are changed only by the writer
+    if (!stamp_.Update(top_module)) {
+        Load(top_module);
+    }
+}
+
+void SdcWriter::Reset(RTLIL::Design *design)
+{
+    false_paths_.clear();
+    timing_paths_.clear();
+    clock_groups_.clear();
+    RTLIL::Module *top_module = design->top_module();
+    for (auto list : {&false_paths_list_, &max_delays_list_, &clock_groups_list_}) {
+        list->clear();
+        if (top_module) {
+            for (auto &chunk : FindChunks(top_module, list->attribute)) {
+                top_module->attributes.erase(chunk.second);
+            }
+        }
+    }
+    if (!top_module) {
+        stamp_ = CacheStamp();
+        return;
+    }
+    stamp_.Update(top_module);
+}
+
+std::vector<std::vector<std::string>> SdcWriter::LoadList(RTLIL::Module *module, StoredList &list, size_t fields_count)
+{
+    list.clear();
+    std::vector<std::vector<std::string>> loaded;
+    for (auto &chunk : FindChunks(module, list.attribute)) {
+        list.chunks = chunk.first + 1;
+        list.last_chunk = module->get_string_attribute(chunk.second);
+        auto constraints = SplitTclList(list.last_chunk);
+        list.last_chunk_size = constraints.size();
+        for (auto &constraint : constraints) {
+            loaded.push_back(SplitTclList(constraint));
+            if (loaded.back().size() != fields_count) {
+                log_cmd_error("Incorrect SDC constraint {%s} in attribute %s of module %s\n", constraint.c_str(),
+                              RTLIL::unescape_id(chunk.second).c_str(), RTLIL::unescape_id(module->name).c_str());
+            }
+        }
+    }
+    return loaded;
+}
+
+void SdcWriter::Load(RTLIL::Module *module)
+{
+    false_paths_.clear();
+    timing_paths_.clear();
+    clock_groups_.clear();
+    for (auto &fields : LoadList(module, false_paths_list_, 3)) {
+        false_paths_.Add(FalsePath{fields[0], fields[2], fields[1]});
+    }
+    for (auto &fields : LoadList(module, max_delays_list_, 3)) {
+        char *end;
+        float max_delay = std::strtof(fields[2].c_str(), &end);
+        if (fields[2].empty() or *end) {
+            log_cmd_error("Incorrect maximum delay %s in the SDC constraints of module %s\n", fields[2].c_str(),
+                          RTLIL::unescape_id(module->name).c_str());
+        }
+        timing_paths_.Add(TimingPath{fields[0], fields[1], max_delay});
+    }
+    for (auto &fields : LoadList(module, clock_groups_list_, 2)) {
+        auto relation = std::find_if(ClockGroups::relation_name_map.begin(), ClockGroups::relation_name_map.end(),
+                                     [&fields](const std::pair<const ClockGroups::ClockGroupRelation, std::string> &relation) {
+                                         return relation.second == fields[0];
+                                     });
+        if (relation == ClockGroups::relation_name_map.end()) {
+            log_cmd_error("Incorrect clock group relation %s in module %s\n", fields[0].c_str(), RTLIL::unescape_id(module->name).c_str());
+        }
+        clock_groups_.Add(SplitTclList(fields[1]), relation->first);
+    }
 }
 
 void SdcWriter::WriteSdc(RTLIL::Design *design, std::ostream &file, bool include_propagated)
 {
+    Sync(design);
+    buffer_.clear();
+    buffer_.reserve(write_block_size + 1024);
     WriteClocks(design, file, include_propagated);
     WriteFalsePaths(file);
     WriteMaxDelay(file);
     WriteClockGroups(file);
+    Flush(file);
 }
 
 void SdcWriter::WriteClocks(RTLIL::Design *design, std::ostream &file, bool include_propagated)
@@ -51,61 +264,97 @@ void SdcWriter::WriteClocks(RTLIL::Design *design, std::ostream &file, bool incl
         if (Clock::IsPropagated(clock_wire) and !include_propagated) {
             continue;
         }
-        file << "create_clock -period " << Clock::Period(clock_wire);
-        file << " -waveform {" << Clock::RisingEdge(clock_wire) << " " << Clock::FallingEdge(clock_wire) << "}";
-        file << " " << Clock::SourceWireName(clock_wire);
-        file << std::endl;
+        buffer_ += "create_clock -period ";
+        AppendFloat(Clock::Period(clock_wire));
+        buffer_ += " -waveform {";
+        AppendFloat(Clock::RisingEdge(clock_wire));
+        buffer_ += ' ';
+        AppendFloat(Clock::FallingEdge(clock_wire));
+        buffer_ += "} ";
+        buffer_ += Clock::SourceWireName(clock_wire);
+        EndLine(file);
     }
 }
 
 void SdcWriter::WriteFalsePaths(std::ostream &file)
 {
-    for (auto path : false_paths_) {
-        file << "set_false_path";
+    for (auto path_ptr : false_paths_.Ordered()) {
+        const auto &path = *path_ptr;
+        buffer_ += "set_false_path";
         if (!path.from_pin.empty()) {
-            file << " -from " << path.from_pin;
+            buffer_ += " -from ";
+            buffer_ += path.from_pin;
         }
         if (!path.through_pin.empty()) {
-            file << " -through " << path.through_pin;
+            buffer_ += " -through ";
+            buffer_ += path.through_pin;
         }
         if (!path.to_pin.empty()) {
-            file << " -to " << path.to_pin;
+            buffer_ += " -to ";
+            buffer_ += path.to_pin;
         }
-        file << std::endl;
+        EndLine(file);
     }
 }
 
 void SdcWriter::WriteMaxDelay(std::ostream &file)
 {
-    for (auto path : timing_paths_) {
-        file << "set_max_delay " << path.max_delay;
+    for (auto path_ptr : timing_paths_.Ordered()) {
+        const auto &path = *path_ptr;
+        buffer_ += "set_max_delay ";
+        AppendFloat(path.max_delay);
         if (!path.from_pin.empty()) {
-            file << " -from " << path.from_pin;
+            buffer_ += " -from ";
+            buffer_ += path.from_pin;
         }
         if (!path.to_pin.empty()) {
-            file << " -to " << path.to_pin;
+            buffer_ += " -to ";
+            buffer_ += path.to_pin;
         }
-        file << std::endl;
+        EndLine(file);
     }
 }
 
 void SdcWriter::WriteClockGroups(std::ostream &file)
 {
     for (size_t relation = 0; relation <= ClockGroups::CLOCK_GROUP_RELATION_SIZE; relation++) {
-        auto clock_groups = clock_groups_.GetGroups(static_cast<ClockGroups::ClockGroupRelation>(relation));
+        const auto &clock_groups = clock_groups_.GetGroups(static_cast<ClockGroups::ClockGroupRelation>(relation));
         if (clock_groups.size() == 0) {
             continue;
         }
-        file << "create_clock_groups ";
-        for (auto group : clock_groups) {
-            file << "-group ";
-            for (auto signal : group) {
-                file << signal << " ";
+        buffer_ += "create_clock_groups ";
+        for (const auto &group : clock_groups) {
+            buffer_ += "-group ";
+            for (const auto &signal : group) {
+                buffer_ += signal;
+                buffer_ += ' ';
             }
         }
         if (relation != ClockGroups::ClockGroupRelation::NONE) {
-            file << "-" + ClockGroups::relation_name_map.at(static_cast<ClockGroups::ClockGroupRelation>(relation));
+            buffer_ += "-" + ClockGroups::relation_name_map.at(static_cast<ClockGroups::ClockGroupRelation>(relation));
         }
-        file << std::endl;
+        EndLine(file);
     }
 }
+
+void SdcWriter::AppendFloat(float value)
+{
+    // Same format as the default floating point format of output streams
+    char formatted[32];
+    int size = std::snprintf(formatted, sizeof(formatted), "%g", value);
+    buffer_.append(formatted, size);
+}
+
+void SdcWriter::EndLine(std::ostream &file)
+{
+    buffer_ += '\n';
+    if (buffer_.size() >= write_block_size) {
+        Flush(file);
+    }
+}
+
+void SdcWriter::Flush(std::ostream &file)
+{
+    file.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
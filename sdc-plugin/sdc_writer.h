@@ -18,7 +18,9 @@
 #ifndef _SDC_WRITER_H_
 #define _SDC_WRITER_H_
 #include "clocks.h"
+#include <algorithm>
 #include <map>
+#include <unordered_set>
 
 USING_YOSYS_NAMESPACE
 
@@ -26,12 +28,62 @@ struct FalsePath {
     std::string from_pin;
     std::string to_pin;
     std::string through_pin;
+
+    bool operator==(const FalsePath &other) const
+    {
+        return from_pin == other.from_pin and to_pin == other.to_pin and through_pin == other.through_pin;
+    }
 };
 
 struct TimingPath {
     std::string from_pin;
     std::string to_pin;
     float max_delay;
+
+    bool operator==(const TimingPath &other) const
+    {
+        return from_pin == other.from_pin and to_pin == other.to_pin and max_delay == other.max_delay;
+    }
+};
+
+struct FalsePathHash {
+    size_t operator()(const FalsePath &path) const;
+};
+
+struct TimingPathHash {
+    size_t operator()(const TimingPath &path) const;
+};
+
+// Set of constraints which keeps the order in which they were added and
+// drops the duplicates
+template <typename Constraint, typename Hash> class UniqueConstraints
+{
+  public:
+    // Returns false if the constraint has already been added
+    bool Add(const Constraint &constraint)
+    {
+        auto inserted = index_.insert(constraint);
+        if (inserted.second) {
+            ordered_.push_back(&*inserted.first);
+        }
+        return inserted.second;
+    }
+
+    // Constraints in the order of their addition. The elements of the
+    // unordered set are never moved, so it's safe to keep pointers to them.
+    const std::vector<const Constraint *> &Ordered() const { return ordered_; }
+
+    size_t size() const { return ordered_.size(); }
+
+    void clear()
+    {
+        ordered_.clear();
+        index_.clear();
+    }
+
+  private:
+    std::unordered_set<Constraint, Hash> index_;
+    std::vector<const Constraint *> ordered_;
 };
 
 struct ClockGroups {
@@ -39,37 +91,123 @@ struct ClockGroups {
     using ClockGroup = std::vector<std::string>;
     static const std::map<ClockGroupRelation, std::string> relation_name_map;
 
-    void Add(ClockGroup &group, ClockGroupRelation relation) { groups_[relation].push_back(group); }
-    std::vector<ClockGroup> GetGroups(ClockGroupRelation relation)
+    // Returns false if the group has already been added with the relation
+    bool Add(const ClockGroup &group, ClockGroupRelation relation)
+    {
+        auto &groups = groups_[relation];
+        if (std::find(groups.begin(), groups.end(), group) != groups.end()) {
+            return false;
+        }
+        groups.push_back(group);
+        return true;
+    }
+    const std::vector<ClockGroup> &GetGroups(ClockGroupRelation relation) const
     {
-        if (groups_.count(relation)) {
-            return groups_.at(relation);
+        static const std::vector<ClockGroup> no_groups;
+        auto groups = groups_.find(relation);
+        if (groups != groups_.end()) {
+            return groups->second;
         }
-        return std::vector<ClockGroup>();
+        return no_groups;
     }
     size_t size() { return groups_.size(); }
+    void clear() { groups_.clear(); }
 
   private:
     std::map<ClockGroupRelation, std::vector<ClockGroup>> groups_;
 };
 
+// Writer of the SDC constraints of a design. The timing exceptions and clock
+// groups are stored in the attributes of the top module so that they are kept
+// with the design like the clocks, e.g. when it's pushed with design -push or
+// written to JSON. Each kind of constraint is stored as a Tcl list of the
+// constraints, which are Tcl lists of their fields:
+//   SDC_FALSE_PATHS_<n>   {<from> <through> <to>} ...
+//   SDC_MAX_DELAYS_<n>    {<from> <to> <delay>} ...
+//   SDC_CLOCK_GROUPS_<n>  {<relation> {<clock> ...}} ...
+// The list is split into chunks of a bounded number of constraints stored in
+// the attributes numbered from 0, so that adding a constraint stores only the
+// last chunk. The cached constraints are reloaded from the attributes only
+// when the stamp of the top module shows that the design may have changed.
 class SdcWriter
 {
   public:
-    void AddFalsePath(FalsePath false_path);
-    void SetMaxDelay(TimingPath timing_path);
-    void AddClockGroup(ClockGroups::ClockGroup clock_group, ClockGroups::ClockGroupRelation relation);
+    // Defers storing the constraints in the top module until the end of its
+    // lifetime, so that a command adding many constraints writes the
+    // attributes once instead of on every constraint
+    class DeferredStore
+    {
+      public:
+        DeferredStore(SdcWriter &writer, RTLIL::Design *design) : writer_(writer), design_(design) { writer_.deferred_stores_++; }
+        ~DeferredStore()
+        {
+            if (--writer_.deferred_stores_ == 0) {
+                writer_.Store(design_);
+            }
+        }
+
+      private:
+        SdcWriter &writer_;
+        RTLIL::Design *design_;
+    };
+
+    // The constraints are added only once, the functions return false for duplicates
+    bool AddFalsePath(RTLIL::Design *design, const FalsePath &false_path);
+    bool SetMaxDelay(RTLIL::Design *design, const TimingPath &timing_path);
+    bool AddClockGroup(RTLIL::Design *design, const ClockGroups::ClockGroup &clock_group, ClockGroups::ClockGroupRelation relation);
     void WriteSdc(RTLIL::Design *design, std::ostream &file, bool include_propagated);
+    // Remove the timing exceptions and clock groups from the design
+    void Reset(RTLIL::Design *design);
 
   private:
+    // Constraints of one kind as stored in the top module attributes
+    struct StoredList {
+        explicit StoredList(const char *attribute) : attribute(attribute) {}
+
+        // Name of the attribute storing the chunk of the list
+        std::string ChunkName(size_t index) const;
+        void clear();
+
+        const char *attribute;
+        // Number of the chunks including the last one, which is kept in
+        // memory as it's the only one which still changes
+        size_t chunks = 0;
+        std::string last_chunk;
+        size_t last_chunk_size = 0;
+        bool changed = false;
+    };
+
+    // Make the cached constraints match the ones stored in the top module
+    void Sync(RTLIL::Design *design);
+    void Load(RTLIL::Module *module);
+    // Split the stored list into the fields of every constraint
+    std::vector<std::vector<std::string>> LoadList(RTLIL::Module *module, StoredList &list, size_t fields_count);
+    // Append the constraint to the stored list of its kind and store the
+    // last chunk unless storing is deferred
+    void Append(RTLIL::Design *design, StoredList &list, const std::vector<std::string> &fields);
+    void Store(RTLIL::Design *design);
+    void StoreLastChunk(RTLIL::Module *module, StoredList &list);
+
     void WriteClocks(RTLIL::Design *design, std::ostream &file, bool include_propagated);
     void WriteFalsePaths(std::ostream &file);
     void WriteMaxDelay(std::ostream &file);
     void WriteClockGroups(std::ostream &file);
 
-    std::vector<FalsePath> false_paths_;
-    std::vector<TimingPath> timing_paths_;
+    // The commands are formatted into the output buffer which is written out
+    // to the stream in large blocks instead of being flushed on every line
+    void AppendFloat(float value);
+    void EndLine(std::ostream &file);
+    void Flush(std::ostream &file);
+
+    UniqueConstraints<FalsePath, FalsePathHash> false_paths_;
+    UniqueConstraints<TimingPath, TimingPathHash> timing_paths_;
     ClockGroups clock_groups_;
+    StoredList false_paths_list_{"SDC_FALSE_PATHS"};
+    StoredList max_delays_list_{"SDC_MAX_DELAYS"};
+    StoredList clock_groups_list_{"SDC_CLOCK_GROUPS"};
+    int deferred_stores_ = 0;
+    CacheStamp stamp_;
+    std::string buffer_;
 };
 
 #endif // _SDC_WRITER_H_
@@ -100,7 +100,7 @@ void SetClockGroups::execute(std::vector<std::string> args, RTLIL::Design *desig
         }
         size_t count(0);
         for (auto &group : clock_groups) {
-            sdc_writer_.AddClockGroup(group, clock_groups_relation);
+            sdc_writer_.AddClockGroup(design, group, clock_groups_relation);
             if (!is_quiet) {
                 log("%zu: ", count++);
                 for (auto clk : group) {
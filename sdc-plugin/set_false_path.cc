@@ -16,9 +16,10 @@
  *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 #include "set_false_path.h"
+#include "../common/tcl_list.h"
 #include "kernel/log.h"
+#include "name_index.h"
 #include "sdc_writer.h"
-#include <regex>
 
 USING_YOSYS_NAMESPACE
 
@@ -26,7 +27,8 @@ void SetFalsePath::help()
 {
     //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
     log("\n");
-    log("   set_false_path [-quiet] [-from <net_name>] [-to <net_name>] \n");
+    log("   set_false_path [-quiet] [-regexp] [-from <net_name>] [-to <net_name>] \n");
+    log("                  [-from_list <net_names>] [-to_list <net_names>]\n");
     log("\n");
     log("Set false path on the specified net\n");
     log("\n");
@@ -34,7 +36,11 @@ void SetFalsePath::help()
         "executed.\n");
     log("\n");
     log("    -quiet\n");
-    log("        Don't print the result of the execution to stdout.\n");
+    log("        Don't print the result of the execution to stdout and don't\n");
+    log("        report the points which don't match any design object.\n");
+    log("\n");
+    log("    -regexp\n");
+    log("        Treat the -from, -to and -through points as regular expressions.\n");
     log("\n");
     log("    -from\n");
     log("        List of start points or clocks.\n");
@@ -45,6 +51,27 @@ void SetFalsePath::help()
     log("    -through\n");
     log("        List of through points or clocks.\n");
     log("\n");
+    log("    -from_list\n");
+    log("        Tcl list of start points. A false path is added for each start\n");
+    log("        point.\n");
+    log("\n");
+    log("    -to_list\n");
+    log("        Tcl list of end points. A false path is added for each end point.\n");
+    log("        If -from_list is specified too the lists need to have the same\n");
+    log("        length and the start and end points are paired by their position.\n");
+    log("\n");
+    log("The -from, -to and -through points are resolved against the names of\n");
+    log("the wires, cell pins (<cell>/<port> or <cell>.<port>) and clocks of the\n");
+    log("top module. Glob patterns with the '*' and '?' wildcards or regular\n");
+    log("expressions are replaced by the list of matching objects. Names which\n");
+    log("don't match any object are reported and written out as they are,\n");
+    log("patterns which don't match any object are reported and dropped. If no\n");
+    log("object matches an option the false path isn't added.\n");
+    log("Elements of -from_list and -to_list need to be names, they are only\n");
+    log("checked and can't be combined with -regexp.\n");
+    log("\n");
+    log("A false path which has already been added is ignored.\n");
+    log("\n");
 }
 
 void SetFalsePath::execute(std::vector<std::string> args, RTLIL::Design *design)
@@ -56,9 +83,13 @@ void SetFalsePath::execute(std::vector<std::string> args, RTLIL::Design *design)
 
     size_t argidx;
     bool is_quiet = false;
+    bool is_regexp = false;
     std::string from_pin;
     std::string to_pin;
     std::string through_pin;
+    std::vector<std::string> from_list;
+    std::vector<std::string> to_list;
+    bool is_bulk = false;
 
     // Parse command arguments
     for (argidx = 1; argidx < args.size(); argidx++) {
@@ -68,6 +99,11 @@ void SetFalsePath::execute(std::vector<std::string> args, RTLIL::Design *design)
             continue;
         }
 
+        if (arg == "-regexp") {
+            is_regexp = true;
+            continue;
+        }
+
         if (arg == "-from" and argidx + 1 < args.size()) {
             from_pin = args[++argidx];
             continue;
@@ -83,17 +119,66 @@ void SetFalsePath::execute(std::vector<std::string> args, RTLIL::Design *design)
             continue;
         }
 
+        if (arg == "-from_list" and argidx + 1 < args.size()) {
+            from_list = SplitTclList(args[++argidx]);
+            is_bulk = true;
+            continue;
+        }
+
+        if (arg == "-to_list" and argidx + 1 < args.size()) {
+            to_list = SplitTclList(args[++argidx]);
+            is_bulk = true;
+            continue;
+        }
+
         if (arg.size() > 0 and arg[0] == '-') {
             log_cmd_error("Unknown option %s.\n", arg.c_str());
         }
 
         break;
     }
+    if (is_bulk) {
+        AddFalsePaths(design, from_pin, from_list, to_pin, to_list, through_pin, is_regexp, is_quiet);
+        return;
+    }
     if (!is_quiet) {
         std::string msg = (from_pin.empty()) ? "" : "-from " + from_pin;
         msg += (through_pin.empty()) ? "" : " -through " + through_pin;
         msg += (to_pin.empty()) ? "" : " -to " + to_pin;
         log("Adding false path %s\n", msg.c_str());
     }
-    sdc_writer_.AddFalsePath(FalsePath{.from_pin = from_pin, .to_pin = to_pin, .through_pin = through_pin});
+    FalsePath path{ResolveEndpoints(design, from_pin, is_regexp, "-from", is_quiet), ResolveEndpoints(design, to_pin, is_regexp, "-to", is_quiet),
+                   ResolveEndpoints(design, through_pin, is_regexp, "-through", is_quiet)};
+    if ((path.from_pin.empty() and !from_pin.empty()) or (path.to_pin.empty() and !to_pin.empty()) or
+        (path.through_pin.empty() and !through_pin.empty())) {
+        if (!is_quiet) {
+            log_warning("No design object matches the false path, it isn't added\n");
+        }
+        return;
+    }
+    if (!sdc_writer_.AddFalsePath(design, path) and !is_quiet) {
+        log("False path has already been added\n");
+    }
+}
+
+void SetFalsePath::AddFalsePaths(RTLIL::Design *design, const std::string &from_pin, const std::vector<std::string> &from_list,
+                                 const std::string &to_pin, const std::vector<std::string> &to_list, const std::string &through_pin, bool is_regexp,
+                                 bool is_quiet)
+{
+    auto pairs = PairEndpointLists(design, from_pin, from_list, to_pin, to_list, is_regexp, is_quiet);
+    std::string through_point(ResolveEndpoints(design, through_pin, false, "-through", is_quiet));
+    if (through_point.empty() and !through_pin.empty()) {
+        if (!is_quiet) {
+            log_warning("No design object matches the -through point, no false paths are added\n");
+        }
+        return;
+    }
+    size_t added_count = 0;
+    SdcWriter::DeferredStore deferred_store(sdc_writer_, design);
+    for (auto &pair : pairs) {
+        added_count += sdc_writer_.AddFalsePath(design, FalsePath{pair.first, pair.second, through_point});
+    }
+    if (!is_quiet) {
+        log("Added %zu false paths, %zu duplicates ignored\n", added_count, pairs.size() - added_count);
+    }
 }
@@ -31,6 +31,10 @@ struct SetFalsePath : public Pass {
 
     void execute(std::vector<std::string> args, RTLIL::Design *design) override;
 
+    // Add a false path for each start and/or end point from the lists
+    void AddFalsePaths(RTLIL::Design *design, const std::string &from_pin, const std::vector<std::string> &from_list, const std::string &to_pin,
+                       const std::vector<std::string> &to_list, const std::string &through_pin, bool is_regexp, bool is_quiet);
+
     SdcWriter &sdc_writer_;
 };
 
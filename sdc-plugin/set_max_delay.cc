@@ -16,7 +16,9 @@
  *  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
  */
 #include "set_max_delay.h"
+#include "../common/tcl_list.h"
 #include "kernel/log.h"
+#include "name_index.h"
 #include "sdc_writer.h"
 
 USING_YOSYS_NAMESPACE
@@ -25,7 +27,8 @@ void SetMaxDelay::help()
 {
     //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
     log("\n");
-    log("   set_max_delay [-quiet] [-from <arg>] [-to <arg>] \n");
+    log("   set_max_delay [-quiet] [-regexp] [-from <arg>] [-to <arg>] \n");
+    log("                 [-from_list <args>] [-to_list <args>] <delay>\n");
     log("\n");
     log("Specify maximum delay for timing paths\n");
     log("\n");
@@ -33,7 +36,11 @@ void SetMaxDelay::help()
         "executed.\n");
     log("\n");
     log("    -quiet\n");
-    log("        Don't print the result of the execution to stdout.\n");
+    log("        Don't print the result of the execution to stdout and don't\n");
+    log("        report the points which don't match any design object.\n");
+    log("\n");
+    log("    -regexp\n");
+    log("        Treat the -from and -to points as regular expressions.\n");
     log("\n");
     log("    -from\n");
     log("        List of start points or clocks.\n");
@@ -41,6 +48,27 @@ void SetMaxDelay::help()
     log("    -to\n");
     log("        List of end points or clocks.\n");
     log("\n");
+    log("    -from_list\n");
+    log("        Tcl list of start points. A maximum delay is set for each start\n");
+    log("        point.\n");
+    log("\n");
+    log("    -to_list\n");
+    log("        Tcl list of end points. A maximum delay is set for each end point.\n");
+    log("        If -from_list is specified too the lists need to have the same\n");
+    log("        length and the start and end points are paired by their position.\n");
+    log("\n");
+    log("The -from and -to points are resolved against the names of the wires,\n");
+    log("cell pins (<cell>/<port> or <cell>.<port>) and clocks of the top module.\n");
+    log("Glob patterns with the '*' and '?' wildcards or regular expressions are\n");
+    log("replaced by the list of matching objects. Names which don't match any\n");
+    log("object are reported and written out as they are, patterns which don't\n");
+    log("match any object are reported and dropped. If no object matches an\n");
+    log("option the maximum delay isn't set. Elements of -from_list and\n");
+    log("-to_list need to be names, they are only checked and can't be\n");
+    log("combined with -regexp.\n");
+    log("\n");
+    log("A maximum delay which has already been set is ignored.\n");
+    log("\n");
 }
 
 void SetMaxDelay::execute(std::vector<std::string> args, RTLIL::Design *design)
@@ -52,8 +80,12 @@ void SetMaxDelay::execute(std::vector<std::string> args, RTLIL::Design *design)
 
     size_t argidx;
     bool is_quiet = false;
+    bool is_regexp = false;
     std::string from_pin;
     std::string to_pin;
+    std::vector<std::string> from_list;
+    std::vector<std::string> to_list;
+    bool is_bulk = false;
     float max_delay(0.0);
 
     // Parse command arguments
@@ -64,6 +96,11 @@ void SetMaxDelay::execute(std::vector<std::string> args, RTLIL::Design *design)
             continue;
         }
 
+        if (arg == "-regexp") {
+            is_regexp = true;
+            continue;
+        }
+
         if (arg == "-from" and argidx + 1 < args.size()) {
             from_pin = args[++argidx];
             log("From: %s\n", from_pin.c_str());
@@ -76,6 +113,18 @@ void SetMaxDelay::execute(std::vector<std::string> args, RTLIL::Design *design)
             continue;
         }
 
+        if (arg == "-from_list" and argidx + 1 < args.size()) {
+            from_list = SplitTclList(args[++argidx]);
+            is_bulk = true;
+            continue;
+        }
+
+        if (arg == "-to_list" and argidx + 1 < args.size()) {
+            to_list = SplitTclList(args[++argidx]);
+            is_bulk = true;
+            continue;
+        }
+
         if (arg.size() > 0 and arg[0] == '-') {
             log_cmd_error("Unknown option %s.\n", arg.c_str());
         }
@@ -83,10 +132,38 @@ void SetMaxDelay::execute(std::vector<std::string> args, RTLIL::Design *design)
         max_delay = std::stof(args[argidx]);
     }
 
+    if (is_bulk) {
+        SetMaxDelays(design, from_pin, from_list, to_pin, to_list, max_delay, is_regexp, is_quiet);
+        return;
+    }
     if (!is_quiet) {
         std::string msg = (from_pin.empty()) ? "" : "-from " + from_pin;
         msg += (to_pin.empty()) ? "" : " -to " + to_pin;
         log("Adding max path delay of %f on path %s\n", max_delay, msg.c_str());
     }
-    sdc_writer_.SetMaxDelay(TimingPath{.from_pin = from_pin, .to_pin = to_pin, .max_delay = max_delay});
+    TimingPath path{ResolveEndpoints(design, from_pin, is_regexp, "-from", is_quiet), ResolveEndpoints(design, to_pin, is_regexp, "-to", is_quiet),
+                    max_delay};
+    if ((path.from_pin.empty() and !from_pin.empty()) or (path.to_pin.empty() and !to_pin.empty())) {
+        if (!is_quiet) {
+            log_warning("No design object matches the path, max path delay isn't set\n");
+        }
+        return;
+    }
+    if (!sdc_writer_.SetMaxDelay(design, path) and !is_quiet) {
+        log("Max path delay has already been set\n");
+    }
+}
+
+void SetMaxDelay::SetMaxDelays(RTLIL::Design *design, const std::string &from_pin, const std::vector<std::string> &from_list,
+                               const std::string &to_pin, const std::vector<std::string> &to_list, float max_delay, bool is_regexp, bool is_quiet)
+{
+    auto pairs = PairEndpointLists(design, from_pin, from_list, to_pin, to_list, is_regexp, is_quiet);
+    size_t added_count = 0;
+    SdcWriter::DeferredStore deferred_store(sdc_writer_, design);
+    for (auto &pair : pairs) {
+        added_count += sdc_writer_.SetMaxDelay(design, TimingPath{pair.first, pair.second, max_delay});
+    }
+    if (!is_quiet) {
+        log("Set max path delay of %f on %zu paths, %zu duplicates ignored\n", max_delay, added_count, pairs.size() - added_count);
+    }
 }
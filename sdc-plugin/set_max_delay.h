@@ -31,6 +31,10 @@ struct SetMaxDelay : public Pass {
 
     void execute(std::vector<std::string> args, RTLIL::Design *design) override;
 
+    // Set the maximum delay for each start and/or end point from the lists
+    void SetMaxDelays(RTLIL::Design *design, const std::string &from_pin, const std::vector<std::string> &from_list, const std::string &to_pin,
+                      const std::vector<std::string> &to_list, float max_delay, bool is_regexp, bool is_quiet);
+
     SdcWriter &sdc_writer_;
 };
 
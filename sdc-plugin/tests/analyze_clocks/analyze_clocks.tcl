@@ -0,0 +1,18 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -auto-top
+
+# clk_a and clk_b repeat every 20 ns, clk_c repeats with clk_b after 13332 ns
+# and with clk_a only after 33330 ns
+create_clock -period 10 clk_a
+create_clock -period 4 clk_b
+create_clock -period 3.333 clk_c
+
+analyze_clocks -threshold 100 -add_clock_groups
+
+# The clock groups added by the previous run are not added again
+analyze_clocks -threshold 100 -add_clock_groups
+write_sdc [test_output_path "analyze_clocks.sdc"]
@@ -0,0 +1,11 @@
+module top(
+	input [2:0] in,
+	output [2:0] out
+);
+
+wire clk_a, clk_b, clk_c;
+assign clk_a = in[0];
+assign clk_b = in[1];
+assign clk_c = in[2];
+assign out = {clk_c, clk_b, clk_a};
+endmodule
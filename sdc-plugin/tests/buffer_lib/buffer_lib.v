@@ -0,0 +1,31 @@
+module top(
+	input clk,
+	input data_in,
+	output data_out
+);
+
+wire clk_ibuf, clk_bufg, clk_bufh;
+
+IBUF IBUF_CLK (
+	.I(clk),
+	.O(clk_ibuf)
+);
+
+BUFG BUFG_CLK (
+	.I(clk_ibuf),
+	.O(clk_bufg)
+);
+
+BUFH BUFH_CLK (
+	.I(clk_bufg),
+	.O(clk_bufh)
+);
+
+FDCE FDCE_BUFH (
+	.D(data_in),
+	.C(clk_bufh),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out)
+);
+endmodule
@@ -0,0 +1,69 @@
+module top(
+	input clk,
+	input data_in,
+	output [2:0] data_out
+);
+
+wire clk_ibuf, clk_bufg;
+wire mmcm_fb;
+wire mmcm_clkout0, mmcm_clkout1;
+wire bufr_out;
+
+IBUF IBUF_CLK (
+	.I(clk),
+	.O(clk_ibuf)
+);
+
+BUFG BUFG_CLK (
+	.I(clk_ibuf),
+	.O(clk_bufg)
+);
+
+MMCME2_ADV #(
+	.CLKFBOUT_MULT_F(10.0),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE_F(5.0),
+	.CLKOUT1_DIVIDE(5'd20),
+	.CLKOUT1_PHASE(90.0),
+	.DIVCLK_DIVIDE(1'd1)
+) MMCM (
+	.CLKFBIN(mmcm_fb),
+	.CLKIN1(clk_bufg),
+	.CLKFBOUT(mmcm_fb),
+	.CLKOUT0(mmcm_clkout0),
+	.CLKOUT1(mmcm_clkout1)
+);
+
+BUFR #(
+	.BUFR_DIVIDE("4")
+) BUFR_CLK (
+	.I(clk_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.O(bufr_out)
+);
+
+FDCE FDCE_MMCM_0 (
+	.D(data_in),
+	.C(mmcm_clkout0),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[0])
+);
+
+FDCE FDCE_MMCM_1 (
+	.D(data_in),
+	.C(mmcm_clkout1),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[1])
+);
+
+FDCE FDCE_BUFR (
+	.D(data_in),
+	.C(bufr_out),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[2])
+);
+endmodule
@@ -0,0 +1,27 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -auto-top
+
+# Duplicated false path
+set_false_path -from clk -to a
+set_false_path -from clk -to a
+
+# False paths between pairs of start and end points
+set_false_path -from_list {a b {c[0]}} -to_list {x y z}
+set_false_path -from a -to x
+
+# False paths to each of the end points
+set_false_path -through t -to_list {x y}
+
+# Duplicated max delay
+set_max_delay 1 -from clk -to a
+set_max_delay 1 -from clk -to a
+set_max_delay 2 -from clk -to a
+
+# Max delays from each of the start points
+set_max_delay 3 -from_list {a b} -to q
+
+write_sdc [test_output_path "constraints_dedup.sdc"]
@@ -0,0 +1,14 @@
+module top(
+	input clk,
+	input clk2,
+	input clk3,
+	input data_in,
+	output data_out
+);
+
+wire clk_a, clk_b, clk_c;
+assign clk_a = clk;
+assign clk_b = clk2;
+assign clk_c = clk3;
+assign data_out = data_in;
+endmodule
@@ -0,0 +1,24 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+hierarchy -check -auto-top
+
+set_false_path -from clk -to ff_0/D
+set_false_path -through data_1
+set_max_delay 1.5 -from data_2 -to ff_2/D
+set_clock_groups -asynchronous -group {clk} -group {data_0 data_1}
+write_sdc [test_output_path "constraints_json.sdc"]
+write_json [test_output_path "constraints_json.json"]
+
+# The constraints are restored with the design
+design -push
+read_json [test_output_path "constraints_json.json"]
+write_sdc [test_output_path "constraints_json_1.sdc"]
+
+# The constraints of the restored design don't leak into the original one
+set_false_path -to ff_1/D
+design -pop
+write_sdc [test_output_path "constraints_json_2.sdc"]
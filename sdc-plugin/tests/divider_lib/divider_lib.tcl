@@ -0,0 +1,17 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+read_verilog -lib +/xilinx/cells_xtra.v
+hierarchy -check -auto-top
+
+# Read the design timing constraints
+read_sdc $::env(DESIGN_TOP).input.sdc
+
+# Propagate the clocks through the clock divider described in the JSON file
+propagate_clocks -divider_lib $::env(DESIGN_TOP).json
+
+# Write out the SDC file after the clock propagation step
+write_sdc [test_output_path "divider_lib.sdc"]
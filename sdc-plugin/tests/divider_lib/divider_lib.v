@@ -0,0 +1,37 @@
+(* blackbox *)
+module CLKDIV(
+	input CLKIN,
+	output CLKOUT
+);
+parameter CLKIN_PERIOD = 0.0;
+parameter MULT = 1;
+parameter DIV = 1;
+parameter PHASE = 0.0;
+endmodule
+
+module top(
+	input clk,
+	input data_in,
+	output data_out
+);
+
+wire clkdiv_out;
+
+CLKDIV #(
+	.CLKIN_PERIOD(10.0),
+	.MULT(2),
+	.DIV(8),
+	.PHASE(45.0)
+) CLKDIV (
+	.CLKIN(clk),
+	.CLKOUT(clkdiv_out)
+);
+
+FDCE FDCE_CLKDIV (
+	.D(data_in),
+	.C(clkdiv_out),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out)
+);
+endmodule
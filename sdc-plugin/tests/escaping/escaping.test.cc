@@ -9,3 +9,16 @@ TEST(ClockTest, EscapeDollarSign)
     // convert $wire_name to \$wire_name
     EXPECT_EQ(Clock::AddEscaping("$wire_name"), "\\$wire_name");
 }
+
+TEST(ClockTest, EscapeSpecialCharacters)
+{
+    // convert $auto$clkbufmap.cc:262:execute$1717 to \$auto\$clkbufmap.cc:262:execute\$1717
+    EXPECT_EQ(Clock::AddEscaping("$auto$clkbufmap.cc:262:execute$1717"), "\\$auto\\$clkbufmap.cc:262:execute\\$1717");
+    // convert bus[3] to bus\[3\]
+    EXPECT_EQ(Clock::AddEscaping("bus[3]"), "bus\\[3\\]");
+    // convert $techmap1617\FDCE_0.C to \$techmap1617\\FDCE_0.C
+    EXPECT_EQ(Clock::AddEscaping("$techmap1617\\FDCE_0.C"), "\\$techmap1617\\\\FDCE_0.C");
+    // convert {a"b;c} to \{a\"b\;c\}
+    EXPECT_EQ(Clock::AddEscaping("{a\"b;c}"), "\\{a\\\"b\\;c\\}");
+    EXPECT_EQ(Clock::AddEscaping(""), "");
+}
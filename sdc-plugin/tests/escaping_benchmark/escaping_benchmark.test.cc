@@ -0,0 +1,51 @@
+#include <clocks.h>
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <regex>
+
+// Measure the throughput of escaping a million hierarchical wire names
+TEST(ClockBenchmark, EscapeHierarchicalNames)
+{
+    const size_t names_count = 1000000;
+    std::vector<std::string> names;
+    names.reserve(names_count);
+    for (size_t idx = 0; idx < names_count; idx++) {
+        switch (idx % 3) {
+        case 0:
+            names.push_back("$auto$clkbufmap.cc:262:execute$" + std::to_string(idx));
+            break;
+        case 1:
+            names.push_back("soc.core.cpu.pipeline_" + std::to_string(idx) + ".clk_div[3]");
+            break;
+        default:
+            names.push_back("soc/core/clk_wire_" + std::to_string(idx));
+            break;
+        }
+    }
+
+    size_t escaped_size(0);
+    auto begin = std::chrono::steady_clock::now();
+    for (auto &name : names) {
+        escaped_size += Clock::AddEscaping(name).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - begin).count();
+
+    // Reference implementation escaping only the dollar signs
+    const size_t reference_count = names_count / 10;
+    auto reference_begin = std::chrono::steady_clock::now();
+    for (size_t idx = 0; idx < reference_count; idx++) {
+        escaped_size += std::regex_replace(names[idx], std::regex{"\\$"}, "\\$").size();
+    }
+    auto reference_end = std::chrono::steady_clock::now();
+    double reference_seconds = std::chrono::duration<double>(reference_end - reference_begin).count();
+
+    std::cout << "AddEscaping: " << names_count << " names in " << seconds << " s (" << names_count / seconds << " names/s)" << std::endl;
+    std::cout << "std::regex_replace: " << reference_count << " names in " << reference_seconds << " s ("
+              << reference_count / reference_seconds << " names/s)" << std::endl;
+    EXPECT_GT(escaped_size, names_count);
+    // Escaping all the special characters with a single scan needs to be
+    // faster than escaping just one of them with a regular expression
+    EXPECT_GT(names_count / seconds, reference_count / reference_seconds);
+}
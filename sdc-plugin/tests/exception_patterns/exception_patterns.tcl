@@ -0,0 +1,33 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+hierarchy -check -auto-top
+
+# Glob pattern matching the D pins of all flip-flops
+set_false_path -from clk -to ff_*/D
+
+# Pin name with the dot separator
+set_false_path -to ff_0.Q
+
+# Name not matching any design object
+set_false_path -from missing_wire
+
+# List of pins, e.g. returned by get_pins
+set_false_path -to [list ff_1/CE ff_2/CE]
+
+# Pattern not matching any design object is dropped from the list
+set_false_path -from ff_0.Q -to {ff_1/D missing_*}
+
+# No design object matches the pattern, the false path isn't added
+set_false_path -to missing_*
+
+# Pattern of the single start point is resolved for every element of the list
+set_false_path -from ff_0/C* -to_list {ff_1/D ff_2/D}
+
+# Regular expression matching two of the wires
+set_max_delay 2 -regexp -from {data_[01]} -to ff_2/D
+
+write_sdc [test_output_path "exception_patterns.sdc"]
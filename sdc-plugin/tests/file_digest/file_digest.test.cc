@@ -0,0 +1,40 @@
+#include "../common/constraints_file.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <sstream>
+
+TEST(ConstraintsFileTest, Digest)
+{
+    FileDigest digest;
+    EXPECT_EQ(digest.str(), "0 bytes, 0 lines, FNV-1a hash cbf29ce484222325");
+    digest.update("a", 1);
+    EXPECT_EQ(digest.str(), "1 bytes, 1 lines, FNV-1a hash af63dc4c8601ec8c");
+    digest.update("\n", 1);
+    EXPECT_EQ(digest.lines, 1u);
+    // A line split between the updates is counted once
+    digest.update("b", 1);
+    digest.update("c\n", 2);
+    EXPECT_EQ(digest.lines, 2u);
+}
+
+TEST(ConstraintsFileTest, ReadFile)
+{
+    std::string lines("create_clock -period 10 clk\nset_false_path -from clk\n");
+    std::string content(lines);
+    // Make the content span several read blocks
+    while (content.size() < 200 * 1024) {
+        content += lines;
+    }
+    std::istringstream stream(content);
+    FileDigest digest;
+    EXPECT_EQ(read_constraints_file(stream, digest), content);
+    EXPECT_EQ(digest.size, content.size());
+    EXPECT_EQ(digest.lines, static_cast<size_t>(std::count(content.begin(), content.end(), '\n')));
+
+    // Count the last line without a newline
+    std::istringstream unterminated("create_clock -period 10 clk\nset_false_path -from clk");
+    FileDigest unterminated_digest;
+    read_constraints_file(unterminated, unterminated_digest);
+    EXPECT_EQ(unterminated_digest.lines, 2u);
+}
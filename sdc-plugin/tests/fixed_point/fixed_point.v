@@ -0,0 +1,72 @@
+module top(
+	input clk,
+	input data_in,
+	output data_out
+);
+
+wire clk_ibuf, clk_bufg;
+wire pll0_fb, pll0_clkout0, pll0_bufg;
+wire pll1_fb, pll1_clkout0, pll1_bufg;
+wire bufr_out;
+
+IBUF IBUF_CLK (
+	.I(clk),
+	.O(clk_ibuf)
+);
+
+BUFG BUFG_CLK (
+	.I(clk_ibuf),
+	.O(clk_bufg)
+);
+
+PLLE2_ADV #(
+	.CLKFBOUT_MULT(4'd8),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE(4'd4),
+	.DIVCLK_DIVIDE(1'd1)
+) PLL0 (
+	.CLKFBIN(pll0_fb),
+	.CLKIN1(clk_bufg),
+	.CLKFBOUT(pll0_fb),
+	.CLKOUT0(pll0_clkout0)
+);
+
+BUFG BUFG_PLL0 (
+	.I(pll0_clkout0),
+	.O(pll0_bufg)
+);
+
+PLLE2_ADV #(
+	.CLKFBOUT_MULT(4'd8),
+	.CLKIN1_PERIOD(5.0),
+	.CLKOUT0_DIVIDE(5'd16),
+	.DIVCLK_DIVIDE(1'd1)
+) PLL1 (
+	.CLKFBIN(pll1_fb),
+	.CLKIN1(pll0_bufg),
+	.CLKFBOUT(pll1_fb),
+	.CLKOUT0(pll1_clkout0)
+);
+
+BUFG BUFG_PLL1 (
+	.I(pll1_clkout0),
+	.O(pll1_bufg)
+);
+
+BUFR #(
+	.BUFR_DIVIDE("2")
+) BUFR_PLL1 (
+	.I(pll1_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.O(bufr_out)
+);
+
+FDCE FDCE_BUFR (
+	.D(data_in),
+	.C(bufr_out),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out)
+);
+endmodule
@@ -0,0 +1,31 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+read_verilog -lib +/xilinx/cells_xtra.v
+hierarchy -check -auto-top
+# Start flow after library reading
+synth_xilinx -flatten -abc9 -nosrl -nodsp -iopad -run prepare:check
+
+# Read the design's timing constraints
+read_sdc $::env(DESIGN_TOP).input.sdc
+
+# Propagate the clocks
+propagate_clocks
+
+# Write the clocks matching the patterns to file
+set fh [open [test_output_path "get_clocks_patterns.txt"] w]
+
+puts $fh [get_clocks clk*]
+
+puts $fh [get_clocks -include_generated_clocks *execute*]
+
+puts $fh [get_clocks -include_generated_clocks -regexp {clk[0-9]}]
+
+puts $fh [get_clocks -include_generated_clocks -of clk_int_?]
+
+puts $fh [get_clocks -of [list clk clk2] clk?]
+
+close $fh
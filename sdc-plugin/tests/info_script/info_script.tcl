@@ -0,0 +1,15 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -auto-top
+
+# The constraints source another file relative to [info script]
+set script [info script]
+read_sdc $::env(DESIGN_TOP).input.sdc
+if {[info script] != $script} {
+	error "The script file name hasn't been restored after read_sdc"
+}
+
+write_sdc [test_output_path "info_script.sdc"]
@@ -0,0 +1,82 @@
+module top(
+	input clk,
+	input data_in,
+	output [3:0] data_out
+);
+
+wire clk_ibuf, clk_bufg;
+wire mmcm_a_fb, mmcm_b_fb;
+wire mmcm_a_clkout0, mmcm_a_clkout1, mmcm_a_clkout2;
+wire mmcm_b_clkout0;
+
+IBUF IBUF_CLK (
+	.I(clk),
+	.O(clk_ibuf)
+);
+
+BUFG BUFG_CLK (
+	.I(clk_ibuf),
+	.O(clk_bufg)
+);
+
+MMCME2_ADV #(
+	.CLKFBOUT_MULT_F(10.0),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE_F(10.0),
+	.CLKOUT1_DIVIDE(5'd10),
+	.CLKOUT2_DIVIDE(5'd20),
+	.CLKOUT2_PHASE(90.0),
+	.DIVCLK_DIVIDE(1'd1)
+) MMCM_A (
+	.CLKFBIN(mmcm_a_fb),
+	.CLKIN1(clk_bufg),
+	.CLKFBOUT(mmcm_a_fb),
+	.CLKOUT0(mmcm_a_clkout0),
+	.CLKOUT1(mmcm_a_clkout1),
+	.CLKOUT2(mmcm_a_clkout2)
+);
+
+MMCME2_ADV #(
+	.CLKFBOUT_MULT_F(10.0),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE_F(10.0),
+	.DIVCLK_DIVIDE(1'd1)
+) MMCM_B (
+	.CLKFBIN(mmcm_b_fb),
+	.CLKIN1(clk_bufg),
+	.CLKFBOUT(mmcm_b_fb),
+	.CLKOUT0(mmcm_b_clkout0)
+);
+
+FDCE FDCE_A_0 (
+	.D(data_in),
+	.C(mmcm_a_clkout0),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[0])
+);
+
+FDCE FDCE_A_1 (
+	.D(data_in),
+	.C(mmcm_a_clkout1),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[1])
+);
+
+FDCE FDCE_A_2 (
+	.D(data_in),
+	.C(mmcm_a_clkout2),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[2])
+);
+
+FDCE FDCE_B_0 (
+	.D(data_in),
+	.C(mmcm_b_clkout0),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[3])
+);
+endmodule
@@ -0,0 +1,82 @@
+module top(
+	input clk,
+	input data_in,
+	output [3:0] data_out
+);
+
+wire clk_ibuf;
+wire clk_bufg_a, clk_bufg_b;
+wire pll_a_fb, pll_b_fb;
+wire pll_a_clkout0, pll_b_clkout0;
+
+IBUF IBUF_CLK (
+	.I(clk),
+	.O(clk_ibuf)
+);
+
+BUFG BUFG_A (
+	.I(clk_ibuf),
+	.O(clk_bufg_a)
+);
+
+BUFG BUFG_B (
+	.I(clk_ibuf),
+	.O(clk_bufg_b)
+);
+
+PLLE2_ADV #(
+	.CLKFBOUT_MULT(4'd8),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE(4'd4),
+	.DIVCLK_DIVIDE(1'd1)
+) PLL_A (
+	.CLKFBIN(pll_a_fb),
+	.CLKIN1(clk_bufg_a),
+	.CLKFBOUT(pll_a_fb),
+	.CLKOUT0(pll_a_clkout0)
+);
+
+PLLE2_ADV #(
+	.CLKFBOUT_MULT(4'd8),
+	.CLKIN1_PERIOD(10.0),
+	.CLKOUT0_DIVIDE(5'd16),
+	.DIVCLK_DIVIDE(1'd1)
+) PLL_B (
+	.CLKFBIN(pll_b_fb),
+	.CLKIN1(clk_bufg_b),
+	.CLKFBOUT(pll_b_fb),
+	.CLKOUT0(pll_b_clkout0)
+);
+
+FDCE FDCE_A (
+	.D(data_in),
+	.C(clk_bufg_a),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[0])
+);
+
+FDCE FDCE_B (
+	.D(data_in),
+	.C(clk_bufg_b),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[1])
+);
+
+FDCE FDCE_PLL_A (
+	.D(data_in),
+	.C(pll_a_clkout0),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[2])
+);
+
+FDCE FDCE_PLL_B (
+	.D(data_in),
+	.C(pll_b_clkout0),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[3])
+);
+endmodule
@@ -0,0 +1,59 @@
+#include <rational.h>
+
+#include <gtest/gtest.h>
+
+TEST(RationalTest, Reduce)
+{
+    EXPECT_EQ(Rational(6, 4), Rational(3, 2));
+    EXPECT_EQ(Rational(3, -6), Rational(-1, 2));
+    EXPECT_EQ(Rational(0, 5), Rational(0));
+    EXPECT_EQ(Rational(-4, -2).Denominator(), 1);
+}
+
+TEST(RationalTest, FromFloat)
+{
+    // Values are rounded to the resolution of the clock attributes
+    EXPECT_EQ(Rational::FromFloat(9.99999f), Rational(999999, 100000));
+    EXPECT_EQ(Rational::FromFloat(0.125), Rational(1, 8));
+    EXPECT_EQ(Rational::FromFloat(-2.5f), Rational(-5, 2));
+}
+
+TEST(RationalTest, Arithmetic)
+{
+    EXPECT_EQ(Rational(1, 3) + Rational(1, 6), Rational(1, 2));
+    EXPECT_EQ(Rational(1, 3) - Rational(1, 2), Rational(-1, 6));
+    EXPECT_EQ(Rational(10) * Rational(12) / Rational(36), Rational(10, 3));
+    // Different order of the operations gives the same result
+    EXPECT_EQ(Rational(10) / Rational(36) * Rational(12), Rational(10) * Rational(12) / Rational(36));
+    EXPECT_FLOAT_EQ(Rational(10, 3).ToFloat(), 10.0f / 3);
+}
+
+TEST(RationalTest, Overflow)
+{
+    const int64_t large = int64_t(1) << 40;
+    EXPECT_THROW(Rational(large) * Rational(large), std::overflow_error);
+    EXPECT_THROW(Rational(1, large) + Rational(1, large - 1), std::overflow_error);
+    EXPECT_THROW(Rational(INT64_MAX) - Rational(-1), std::overflow_error);
+    EXPECT_THROW(Rational::FromFloat(1e20), std::overflow_error);
+    // Common factors are cancelled before multiplying
+    EXPECT_EQ(Rational(large) * Rational(1, large), Rational(1));
+    EXPECT_EQ(Rational(large, 3) + Rational(large, 3), Rational(2 * large, 3));
+}
+
+TEST(RationalTest, Mod)
+{
+    // Same sign convention as fmod
+    EXPECT_EQ(Rational(7, 2).Mod(Rational(1)), Rational(1, 2));
+    EXPECT_EQ(Rational(-15, 8).Mod(Rational(5, 2)), Rational(-15, 8));
+    EXPECT_EQ(Rational(-5, 2).Mod(Rational(5, 2)), Rational(0));
+    EXPECT_EQ(Rational(-7, 2).Mod(Rational(1)), Rational(-1, 2));
+}
+
+TEST(RationalTest, Round)
+{
+    EXPECT_EQ(Rational(999999, 100000).Round(1000), 10000);
+    EXPECT_EQ(Rational(10).Round(1000), 10000);
+    EXPECT_EQ(Rational(1, 2).Round(), 1);
+    EXPECT_EQ(Rational(-1, 2).Round(), -1);
+    EXPECT_EQ(Rational(-1, 3).Round(), 0);
+}
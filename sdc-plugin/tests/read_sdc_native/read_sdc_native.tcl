@@ -0,0 +1,14 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -auto-top
+
+# Read the constraints with the native SDC reader
+read_sdc -native $::env(DESIGN_TOP).input.sdc
+
+# Fall back to Tcl for the constraints using variables
+read_sdc -native $::env(DESIGN_TOP).tcl.sdc
+
+write_sdc [test_output_path "read_sdc_native.sdc"]
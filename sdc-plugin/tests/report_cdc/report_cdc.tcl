@@ -0,0 +1,16 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+hierarchy -check -auto-top
+
+create_clock -period 10 clk_a
+create_clock -period 7 clk_b
+propagate_clocks
+
+# The synchronized crossing gets a false path, the unsynchronized one keeps
+# both domains in the same clock group
+report_cdc -json [test_output_path "report_cdc.json"] -add_false_paths -add_clock_groups
+write_sdc [test_output_path "report_cdc.sdc"]
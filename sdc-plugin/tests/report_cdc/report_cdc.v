@@ -0,0 +1,67 @@
+module top(
+	input clk_a,
+	input clk_b,
+	input data_in,
+	output [1:0] data_out
+);
+
+wire clk_a_ibuf, clk_a_bufg;
+wire clk_b_ibuf, clk_b_bufg;
+wire a_q, sync_0_q, direct_d;
+
+IBUF IBUF_A (
+	.I(clk_a),
+	.O(clk_a_ibuf)
+);
+
+BUFG BUFG_A (
+	.I(clk_a_ibuf),
+	.O(clk_a_bufg)
+);
+
+IBUF IBUF_B (
+	.I(clk_b),
+	.O(clk_b_ibuf)
+);
+
+BUFG BUFG_B (
+	.I(clk_b_ibuf),
+	.O(clk_b_bufg)
+);
+
+FDCE a_ff (
+	.D(data_in),
+	.C(clk_a_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(a_q)
+);
+
+// Two flip-flop synchronizer
+FDCE sync_0 (
+	.D(a_q),
+	.C(clk_b_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(sync_0_q)
+);
+
+FDCE sync_1 (
+	.D(sync_0_q),
+	.C(clk_b_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[0])
+);
+
+// Crossing through logic without a synchronizer
+assign direct_d = a_q & data_in;
+
+FDCE direct_ff (
+	.D(direct_d),
+	.C(clk_b_bufg),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[1])
+);
+endmodule
@@ -0,0 +1,13 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -top top
+
+create_clock -period 10 clk_a
+create_clock -period 7 clk_b
+
+# The flip-flops are clocked on the CLK port of the vendor cells
+report_cdc -json [test_output_path "report_cdc_vendor.json"] -add_false_paths
+write_sdc [test_output_path "report_cdc_vendor.sdc"]
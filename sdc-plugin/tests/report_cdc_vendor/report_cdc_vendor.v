@@ -0,0 +1,49 @@
+// QuickLogic flip-flop with the clock on the CLK port
+(* blackbox *)
+module dffepc(
+	output Q,
+	input D,
+	input CLK,
+	input EN,
+	input CLR,
+	input PRE
+);
+endmodule
+
+module top(
+	input clk_a,
+	input clk_b,
+	input data_in,
+	output data_out
+);
+
+wire a_q, sync_0_q;
+
+dffepc a_ff (
+	.Q(a_q),
+	.D(data_in),
+	.CLK(clk_a),
+	.EN(1'b1),
+	.CLR(1'b0),
+	.PRE(1'b0)
+);
+
+// Two flip-flop synchronizer
+dffepc sync_0 (
+	.Q(sync_0_q),
+	.D(a_q),
+	.CLK(clk_b),
+	.EN(1'b1),
+	.CLR(1'b0),
+	.PRE(1'b0)
+);
+
+dffepc sync_1 (
+	.Q(data_out),
+	.D(sync_0_q),
+	.CLK(clk_b),
+	.EN(1'b1),
+	.CLR(1'b0),
+	.PRE(1'b0)
+);
+endmodule
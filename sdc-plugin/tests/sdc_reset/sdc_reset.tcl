@@ -0,0 +1,23 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+hierarchy -check -auto-top
+
+set_false_path -from clk -to ff_0/D
+set_max_delay 1.5 -from data_2 -to ff_2/D
+set_clock_groups -asynchronous -group {clk} -group {data_0}
+
+# Only the constraints added after the reset are written out
+sdc_reset
+set_false_path -to ff_1/D
+write_sdc [test_output_path "sdc_reset.sdc"]
+
+# The constraints of the previous design aren't carried over to a new one
+design -reset
+read_verilog $::env(DESIGN_TOP).v
+read_verilog -specify -lib -D_EXPLICIT_CARRY +/xilinx/cells_sim.v
+hierarchy -check -auto-top
+write_sdc [test_output_path "sdc_reset_1.sdc"]
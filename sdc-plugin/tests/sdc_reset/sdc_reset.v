@@ -0,0 +1,35 @@
+module top(
+	input clk,
+	input [2:0] data_in,
+	output [2:0] data_out
+);
+
+wire data_0, data_1, data_2;
+assign data_0 = data_in[0];
+assign data_1 = data_in[1];
+assign data_2 = data_in[2];
+
+FDCE ff_0 (
+	.D(data_0),
+	.C(clk),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[0])
+);
+
+FDCE ff_1 (
+	.D(data_1),
+	.C(clk),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[1])
+);
+
+FDCE ff_2 (
+	.D(data_2),
+	.C(clk),
+	.CE(1'b1),
+	.CLR(1'b0),
+	.Q(data_out[2])
+);
+endmodule
@@ -0,0 +1,21 @@
+yosys -import
+if { [info procs read_sdc] == {} } { plugin -i sdc }
+yosys -import  ;# ingest plugin commands
+
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -check -auto-top
+
+# Generate 100k false paths
+set from_list {}
+set to_list {}
+for {set idx 0} {$idx < 100000} {incr idx} {
+    lappend from_list soc/core/reg_$idx/Q
+    lappend to_list soc/core/reg_[expr {$idx + 1}]/D
+}
+set_false_path -quiet -from_list $from_list -to_list $to_list
+
+# Measure the time of writing out the false paths
+set start [clock microseconds]
+write_sdc [test_output_path "write_sdc_benchmark.sdc"]
+set elapsed [expr {[clock microseconds] - $start}]
+puts "write_sdc of 100000 false paths took [expr {$elapsed / 1000.0}] ms"
@@ -0,0 +1,9 @@
+module top(
+	input clk,
+	input data_in,
+	output reg data_out
+);
+
+always @(posedge clk)
+	data_out <= data_in;
+endmodule
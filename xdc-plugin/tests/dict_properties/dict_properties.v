@@ -0,0 +1,53 @@
+module top (
+	input  clk,
+	input  [3:0] sw,
+	output [3:0] led
+);
+
+	wire [3:0] sw_buf;
+
+	IBUF IBUF_CLK (
+		.I(clk),
+		.O()
+	);
+
+	IBUF IBUF_SW_0 (
+		.I(sw[0]),
+		.O(sw_buf[0])
+	);
+
+	IBUF IBUF_SW_1 (
+		.I(sw[1]),
+		.O(sw_buf[1])
+	);
+
+	IBUF IBUF_SW_2 (
+		.I(sw[2]),
+		.O(sw_buf[2])
+	);
+
+	IBUF IBUF_SW_3 (
+		.I(sw[3]),
+		.O(sw_buf[3])
+	);
+
+	OBUF OBUF_LED_0 (
+		.I(sw_buf[0]),
+		.O(led[0])
+	);
+
+	OBUF OBUF_LED_1 (
+		.I(sw_buf[1]),
+		.O(led[1])
+	);
+
+	OBUF OBUF_LED_2 (
+		.I(sw_buf[2]),
+		.O(led[2])
+	);
+
+	OBUF OBUF_LED_3 (
+		.I(sw_buf[3]),
+		.O(led[3])
+	);
+endmodule
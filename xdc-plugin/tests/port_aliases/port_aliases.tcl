@@ -0,0 +1,16 @@
+yosys -import
+if { [info procs get_ports] == {} } { plugin -i design_introspection }
+if { [info procs read_xdc] == {} } { plugin -i xdc }
+yosys -import  ;# ingest plugin commands
+
+# The design isn't synthesized so that the chains of aliases between
+# the top ports and the IO buffers are kept in the netlist
+read_verilog -lib +/xilinx/cells_sim.v
+read_verilog $::env(DESIGN_TOP).v
+hierarchy -top top
+
+#Read the design constraints
+read_xdc -part_json [file dirname [info script]]/../xc7a35tcsg324-1.json $::env(DESIGN_TOP).xdc
+
+# Write the design in JSON format.
+write_json [test_output_path "port_aliases.json"]
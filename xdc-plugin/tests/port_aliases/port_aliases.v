@@ -0,0 +1,62 @@
+module top (
+	input  clk,
+	input  [1:0] in,
+	output [3:0] led
+);
+
+	// The IO buffers are connected to the top ports through chains of aliases
+	wire clk_a, clk_b, clk_c;
+	wire [1:0] in_a;
+	wire in_b;
+	wire [3:0] led_a, led_b;
+	wire led_c;
+
+	assign clk_a = clk;
+	assign clk_b = clk_a;
+	assign clk_c = clk_b;
+
+	assign in_a = in;
+	assign in_b = in_a[1];
+
+	assign led = led_a;
+	assign led_a = {led_b[3:1], led_c};
+	assign led_c = led_b[0];
+
+	wire clk_buf;
+	wire [1:0] in_buf;
+
+	IBUF IBUF_CLK (
+		.I(clk_c),
+		.O(clk_buf)
+	);
+
+	IBUF IBUF_IN_0 (
+		.I(in_a[0]),
+		.O(in_buf[0])
+	);
+
+	IBUF IBUF_IN_1 (
+		.I(in_b),
+		.O(in_buf[1])
+	);
+
+	OBUF OBUF_LED_0 (
+		.I(clk_buf),
+		.O(led_b[0])
+	);
+
+	OBUF OBUF_LED_1 (
+		.I(in_buf[0]),
+		.O(led_b[1])
+	);
+
+	OBUF OBUF_LED_2 (
+		.I(in_buf[1]),
+		.O(led_b[2])
+	);
+
+	OBUF OBUF_LED_3 (
+		.I(clk_buf),
+		.O(led_b[3])
+	);
+endmodule
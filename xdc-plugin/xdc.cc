@@ -27,19 +27,26 @@
  *   Tcl interpreter.
  */
 #include "../common/bank_tiles.h"
+#include "../common/constraints_file.h"
+#include "../common/glob_match.h"
+#include "../common/tcl_list.h"
+#include "../common/tcl_script_file.h"
+#include "../common/top_ports.h"
 #include "kernel/log.h"
 #include "kernel/register.h"
 #include "kernel/rtlil.h"
+#include "kernel/sigtools.h"
 #include "libs/json11/json11.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
+#include <memory>
 
 USING_YOSYS_NAMESPACE
 
 PRIVATE_NAMESPACE_BEGIN
 
-static bool isInputPort(RTLIL::Wire *wire) { return wire->port_input; }
-static bool isOutputPort(RTLIL::Wire *wire) { return wire->port_output; }
-
 enum class SetPropertyOptions { INTERNAL_VREF, IOSTANDARD, SLEW, DRIVE, IN_TERM, IO_LOC_PAIRS };
 
 const std::unordered_map<std::string, SetPropertyOptions> set_property_options_map = {{"INTERNAL_VREF", SetPropertyOptions::INTERNAL_VREF},
@@ -59,6 +66,47 @@ const std::unordered_map<std::string, std::vector<std::string>> supported_primit
   {"IOBUFDS", {"IO_LOC_PAIRS", "IOSTANDARD", "SLEW", "IN_TERM"}},
   {"IBUFDS_GTE2", {"IO_LOC_PAIRS"}}};
 
+// Index of the supported IO primitive cells by the wire bits connected to
+// their ports. The bits are mapped to the canonical bits of their nets, so a
+// top port reaches its IO cell through any chain of assignments. Building it
+// takes a single pass over the cells of the module, after which the cells
+// connected to a port bit are found in constant time. The bits of the top
+// ports are listed with their names for expanding the port name patterns.
+struct IoCellIndex {
+    IoCellIndex(RTLIL::Module *module) : module(module), sigmap(module), port_bits(TopPortBits(module))
+    {
+        for (auto cell : module->cells()) {
+            if (supported_primitive_parameters.count(RTLIL::unescape_id(cell->type)) == 0) {
+                continue;
+            }
+            for (auto &connection : cell->connections()) {
+                for (auto bit : sigmap(connection.second)) {
+                    if (!bit.wire) {
+                        continue;
+                    }
+                    auto &bit_cells = cells[bit];
+                    if (std::find(bit_cells.begin(), bit_cells.end(), cell) == bit_cells.end()) {
+                        bit_cells.push_back(cell);
+                    }
+                }
+            }
+        }
+    }
+
+    // Get the IO cells with a port connected to the net of the given bit
+    const std::vector<RTLIL::Cell *> &Cells(const RTLIL::SigBit &bit) const
+    {
+        static const std::vector<RTLIL::Cell *> no_cells;
+        auto bit_cells = cells.find(sigmap(bit));
+        return bit_cells == cells.end() ? no_cells : bit_cells->second;
+    }
+
+    RTLIL::Module *module;
+    SigMap sigmap;
+    dict<RTLIL::SigBit, std::vector<RTLIL::Cell *>> cells;
+    std::vector<std::pair<std::string, RTLIL::SigBit>> port_bits;
+};
+
 void register_in_tcl_interpreter(const std::string &command)
 {
     Tcl_Interp *interp = yosys_get_tcl_interp();
@@ -101,6 +149,9 @@ struct GetIOBanks : public Pass {
 };
 
 struct SetProperty : public Pass {
+    // Pairs of the names of the top port bits and their IO cells
+    using PortCells = std::vector<std::pair<std::string, std::vector<RTLIL::Cell *>>>;
+
     SetProperty(std::function<const BankTilesMap &()> get_bank_tiles) : Pass("set_property", "Set a given property"), get_bank_tiles(get_bank_tiles)
     {
         register_in_tcl_interpreter(pass_name);
@@ -111,9 +162,18 @@ struct SetProperty : public Pass {
         //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
         log("\n");
         log("    set_property PROPERTY VALUE OBJECT\n");
+        log("    set_property -dict {PROPERTY VALUE ...} OBJECT\n");
         log("\n");
         log("Set the given property to the specified value on an object\n");
         log("\n");
+        log("The object of a port property is a list of port names, e.g. \"{led[0] led[1]}\".\n");
+        log("The names with the * and ? wildcards are expanded to all the matching bits of\n");
+        log("the top ports, e.g. \"data[*]\" matches all the bits of the data bus.\n");
+        log("\n");
+        log("    -dict\n");
+        log("        Set all the properties of the list of property and value pairs.\n");
+        log("        The IO cells of the port are found once for all the properties.\n");
+        log("\n");
     }
 
     void execute(std::vector<std::string> args, RTLIL::Design *design) override
@@ -122,6 +182,11 @@ struct SetProperty : public Pass {
             log_cmd_error("No top module detected\n");
         }
 
+        if (args.size() > 1 and args[1] == "-dict") {
+            process_dict(args, design);
+            return;
+        }
+
         std::string option(args[1]);
         if (set_property_options_map.count(option) == 0) {
             log_warning("set_property: %s option is currently not supported\n", option.c_str());
@@ -139,10 +204,9 @@ struct SetProperty : public Pass {
             process_port_parameter(std::vector<std::string>(args.begin() + 1, args.end()), design);
             break;
         case SetPropertyOptions::IO_LOC_PAIRS: {
-            // args "set_property LOC PAD PORT" become "IO_LOC_PAIRS PORT:PAD PORT"
+            // args "set_property LOC PAD PORT" become "IO_LOC_PAIRS PAD PORT"
             std::vector<std::string> new_args(args.begin() + 1, args.end());
             new_args.at(0) = "IO_LOC_PAIRS";
-            new_args.at(1) = new_args.at(2) + ":" + new_args.at(1);
             process_port_parameter(new_args, design);
             break;
         }
@@ -187,6 +251,45 @@ struct SetProperty : public Pass {
         bank_cell->setParam(ID(INTERNAL_VREF), RTLIL::Const(internal_vref));
     }
 
+    void process_dict(const std::vector<std::string> &args, RTLIL::Design *design)
+    {
+        if (args.size() < 3) {
+            log_error("set_property -dict: Incorrect number of arguments.\n");
+        }
+        std::vector<std::string> properties(SplitTclList(args.at(2)));
+        if (properties.size() % 2 != 0) {
+            log_error("set_property -dict: Missing value of property %s.\n", properties.back().c_str());
+        }
+
+        // The object is empty if get_ports hasn't matched any port
+        std::string object(args.size() > 3 ? args.at(3) : "");
+        PortCells cells;
+        bool port_resolved = false;
+        for (size_t i = 0; i < properties.size(); i += 2) {
+            const std::string &option(properties[i]);
+            const std::string &value(properties[i + 1]);
+            if (set_property_options_map.count(option) == 0) {
+                log_warning("set_property: %s option is currently not supported\n", option.c_str());
+                continue;
+            }
+            auto property = set_property_options_map.at(option);
+            if (property == SetPropertyOptions::INTERNAL_VREF) {
+                process_vref({value, object}, design);
+                continue;
+            }
+            if (!port_resolved) {
+                cells = port_cells(object, design);
+                port_resolved = true;
+            }
+            if (property == SetPropertyOptions::IO_LOC_PAIRS) {
+                set_port_parameter(cells, "IO_LOC_PAIRS", value);
+            } else {
+                set_port_parameter(cells, option, value);
+            }
+        }
+        log("\n");
+    }
+
     void process_port_parameter(std::vector<std::string> args, RTLIL::Design *design)
     {
         if (args.size() < 1) {
@@ -194,130 +297,268 @@ struct SetProperty : public Pass {
         }
 
         std::string parameter(args.at(0));
-        if (args.size() < 3 || args.at(2).size() == 0) {
+        if (args.size() < 2) {
             log_error("set_property %s: Incorrect number of arguments.\n", parameter.c_str());
         }
 
-        std::string port_name(args.at(2));
+        // The ports are empty if get_ports hasn't matched any port
+        std::string port_name(args.size() > 2 ? args.at(2) : "");
         std::string value(args.at(1));
+        set_port_parameter(port_cells(port_name, design), parameter, value);
+        log("\n");
+    }
 
-        auto port_signal = extract_signal(port_name);
-        std::string port(port_signal.first);
-        int port_bit = port_signal.second;
-
-        RTLIL::Wire *wire = design->top_module()->wire(RTLIL::escape_id(port));
-        if (wire == nullptr) {
-            log_error("Couldn't find port %s\n", port_name.c_str());
+    // Get the IO cells connected to each bit of the list of top ports. The
+    // ports are resolved like by get_ports: the port names with wildcards are
+    // expanded in a single pass over the top port bits, the names and
+    // patterns not matching any port are reported and skipped. The list is
+    // required to match at least one port.
+    PortCells port_cells(const std::string &ports, RTLIL::Design *design)
+    {
+        // Use the index of the current read_xdc session or build a temporary one
+        std::unique_ptr<IoCellIndex> local_io_cell_index;
+        const IoCellIndex *io_cell_index = session_io_cell_index.get();
+        if (!io_cell_index or io_cell_index->module != design->top_module()) {
+            local_io_cell_index.reset(new IoCellIndex(design->top_module()));
+            io_cell_index = local_io_cell_index.get();
         }
 
-        if (!isInputPort(wire) && !isOutputPort(wire)) {
-            log_error("Port %s is not a top port\n", port_name.c_str());
+        PortCells cells;
+        for (auto &port_name : SplitTclList(ports)) {
+            auto matches = MatchTopPorts(io_cell_index->module, io_cell_index->port_bits, port_name);
+            if (matches.empty()) {
+                log_warning("Couldn't find port matching %s\n", port_name.c_str());
+            }
+            for (auto &match : matches) {
+                cells.emplace_back(match.first, io_cell_index->Cells(match.second));
+            }
         }
-
-        if (port_bit < wire->start_offset || port_bit >= wire->start_offset + wire->width) {
-            log_error("Incorrect top port index %d in port %s\n", port_bit, port_name.c_str());
+        if (cells.empty()) {
+            log_error("set_property: Couldn't find any port in {%s}\n", ports.c_str());
         }
+        return cells;
+    }
 
-        // Traverse the port wire
-        traverse_wire(port_name, design->top_module());
-
+    // Set the parameter on the IO cells of the ports
+    void set_port_parameter(const PortCells &ports, const std::string &parameter, const std::string &value)
+    {
         RTLIL::IdString parameter_id(RTLIL::escape_id(parameter));
-        for (auto cell_obj : design->top_module()->cells_) {
-            RTLIL::IdString cell_id = cell_obj.first;
-            RTLIL::Cell *cell = cell_obj.second;
-
-            // Check if the cell is of the type we are looking for
-            auto cell_type_str = RTLIL::unescape_id(cell->type.str());
-            auto primitive_parameters_iter = supported_primitive_parameters.find(cell_type_str);
-            if (primitive_parameters_iter == supported_primitive_parameters.end()) {
-                continue;
+        for (auto &port : ports) {
+            // IO_LOC_PAIRS holds the pairs of the port name and the pad
+            std::string port_value(parameter_id == ID(IO_LOC_PAIRS) ? port.first + ":" + value : value);
+            for (auto cell : port.second) {
+                // Check if the attribute is allowed for this module
+                auto &primitive_parameters = supported_primitive_parameters.at(RTLIL::unescape_id(cell->type));
+                if (std::find(primitive_parameters.begin(), primitive_parameters.end(), parameter) == primitive_parameters.end()) {
+                    log_error("Cell %s of type %s doesn't support the %s attribute\n", cell->name.c_str(), cell->type.c_str(),
+                              parameter_id.c_str());
+                }
+                std::string cell_value(port_value);
+                if (parameter_id == ID(IO_LOC_PAIRS) and cell->hasParam(parameter_id)) {
+                    std::string cur_value(cell->getParam(parameter_id).decode_string());
+                    cell_value = cur_value + "," + port_value;
+                }
+                cell->setParam(parameter_id, RTLIL::Const(cell_value));
+                log("Setting parameter %s to value %s on cell %s \n", parameter_id.c_str(), cell_value.c_str(), cell->name.c_str());
             }
+        }
+    }
 
-            // Set the parameter on the cell connected to the selected port
-            for (auto connection : cell->connections_) {
-                RTLIL::SigSpec cell_signal = connection.second;
-                if (is_signal_port(cell_signal, port_name)) {
-                    // Check if the attribute is allowed for this module
-                    auto primitive_parameters = primitive_parameters_iter->second;
-                    if (std::find(primitive_parameters.begin(), primitive_parameters.end(), parameter) == primitive_parameters.end()) {
-                        log_error("Cell %s of type %s doesn't support the %s attribute\n", cell->name.c_str(), cell->type.c_str(),
-                                  parameter_id.c_str());
-                    }
-                    if (parameter_id == ID(IO_LOC_PAIRS) and cell->hasParam(parameter_id)) {
-                        std::string cur_value(cell->getParam(parameter_id).decode_string());
-                        value = cur_value + "," + value;
-                    }
-                    cell->setParam(parameter_id, RTLIL::Const(value));
-                    log("Setting parameter %s to value %s on cell %s \n", parameter_id.c_str(), value.c_str(), cell_obj.first.c_str());
-                }
+    // Start a read_xdc session with the index of the IO cells of the top module
+    void BeginSession(RTLIL::Design *design)
+    {
+        session_io_cell_index.reset(design->top_module() ? new IoCellIndex(design->top_module()) : nullptr);
+    }
+
+    void EndSession() { session_io_cell_index.reset(); }
+
+    std::function<const BankTilesMap &()> get_bank_tiles;
+    std::unique_ptr<IoCellIndex> session_io_cell_index;
+};
+
+// Parser of the XDC lines which are executed without the Tcl interpreter.
+// It accepts only the set_property commands on the ports given literally, i.e.
+//
+//   set_property <property> <value> [get_ports <ports>]
+//   set_property -dict {<property> <value> ...} [get_ports <ports>]
+//
+// as well as comments and empty lines. The ports are a single name or a list in curly braces,
+// which are expanded by set_property. Bus indexes and the * wildcard may be given without
+// the curly braces, e.g. "[get_ports signal[5]]", the same as in the Tcl evaluated lines.
+// The lines with any other Tcl constructs, e.g. variables, quotes, other commands
+// or several commands, are rejected and have to be evaluated by the Tcl interpreter.
+struct XdcLineParser {
+    XdcLineParser(const std::string &line) : line(line), pos(0) {}
+
+    // Parse the line into the arguments of the set_property command, which are empty for
+    // a comment or an empty line. Returns false if the line has to be evaluated by Tcl.
+    bool Parse(std::vector<std::string> &args)
+    {
+        SkipSpaces();
+        // A comment ending with a backslash continues in the next line
+        if (pos == line.size() or (line[pos] == '#' and line.back() != '\\')) {
+            return true;
+        }
+        std::string command;
+        if (!ParseWord(command, false) or command != "set_property") {
+            return false;
+        }
+        std::string property, value;
+        if (!ParseWord(property, false) or !ParseWord(value, false)) {
+            return false;
+        }
+        if (property == "-dict") {
+            std::vector<std::string> dict(SplitWords(value));
+            if (dict.empty() or dict.size() % 2 != 0) {
+                return false;
             }
         }
-        log("\n");
+        std::string port;
+        if (!ParseGetPorts(port) or !AtEnd()) {
+            return false;
+        }
+        args = {command, property, value, port};
+        return true;
     }
 
-    // Search module's connections for the specified destination port
-    // and traverse from the specified destination wire to the source wire
-    void traverse_wire(std::string &port_name, RTLIL::Module *module)
+    void SkipSpaces()
     {
-        auto port_signal = extract_signal(port_name);
-        std::string signal_name(port_signal.first);
-        auto signal_name_idstr = RTLIL::IdString(RTLIL::escape_id(signal_name));
-        int port_bit = port_signal.second;
-        for (auto connection : module->connections_) {
-            auto dst_sig = connection.first;
-            auto src_sig = connection.second;
-            if (dst_sig.is_chunk()) {
-                auto chunk = dst_sig.as_chunk();
-                if (chunk.wire) {
-                    if (chunk.wire->name != signal_name_idstr) {
-                        continue;
-                    }
-                    if (port_bit < chunk.offset || port_bit >= (chunk.offset + chunk.width)) {
-                        continue;
-                    }
-                    auto src_wires = src_sig.to_sigbit_vector();
-                    auto src_wire_sigbit = src_wires.at(port_bit - chunk.offset);
-                    if (src_wire_sigbit.wire) {
-                        port_name = src_wires.at(port_bit - chunk.offset).wire->name.str();
-                        if (src_wire_sigbit.offset > 0) {
-                            port_name += "[" + std::to_string(src_wire_sigbit.offset) + "]";
-                        }
-                        return;
-                    }
+        while (pos < line.size() and (line[pos] == ' ' or line[pos] == '\t' or line[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    bool AtEnd()
+    {
+        SkipSpaces();
+        return pos == line.size();
+    }
+
+    // A word ends with a white space, the end of the line or the closing bracket of a nested command
+    bool AtWordEnd(bool nested) const
+    {
+        return pos == line.size() or line[pos] == ' ' or line[pos] == '\t' or line[pos] == '\r' or (nested and line[pos] == ']');
+    }
+
+    // Parse a bare word or a word in curly braces without nested braces and backslashes
+    bool ParseWord(std::string &word, bool nested)
+    {
+        SkipSpaces();
+        if (pos == line.size()) {
+            return false;
+        }
+        if (line[pos] == '{') {
+            size_t end = line.find_first_of("{}\\", pos + 1);
+            if (end == std::string::npos or line[end] != '}') {
+                return false;
+            }
+            word.assign(line, pos + 1, end - pos - 1);
+            pos = end + 1;
+            return AtWordEnd(nested);
+        }
+        size_t start = pos;
+        while (!AtWordEnd(nested)) {
+            char c = line[pos];
+            if (c == '[') {
+                // Only the bus indexes, e.g. "signal[5]", and "signal[*]" are accepted in the brackets
+                size_t end = pos + 1;
+                while (end < line.size() and std::isdigit(static_cast<unsigned char>(line[end]))) {
+                    end++;
                 }
+                if (end == pos + 1 and end < line.size() and line[end] == '*') {
+                    end++;
+                }
+                if (pos == start or end == pos + 1 or end == line.size() or line[end] != ']') {
+                    return false;
+                }
+                pos = end + 1;
+                continue;
+            }
+            if (std::strchr("$\\\";{}]", c)) {
+                return false;
             }
+            pos++;
         }
+        word.assign(line, start, pos - start);
+        return !word.empty();
     }
 
-    // Extract signal name and port bit information from port name
-    std::pair<std::string, int> extract_signal(const std::string &port_name)
+    // Parse the "[get_ports <ports>]" command substitution
+    bool ParseGetPorts(std::string &port)
     {
-        int port_bit(0);
-        std::string port_str(port_name.size(), '\0');
-        sscanf(port_name.c_str(), "%[^[][%d]", &port_str[0], &port_bit);
-        port_str.resize(strlen(port_str.c_str()));
-        return std::make_pair(port_str, port_bit);
+        SkipSpaces();
+        if (pos == line.size() or line[pos] != '[') {
+            return false;
+        }
+        pos++;
+        std::string command;
+        if (!ParseWord(command, true) or command != "get_ports" or !ParseWord(port, true)) {
+            return false;
+        }
+        SkipSpaces();
+        if (pos == line.size() or line[pos] != ']') {
+            return false;
+        }
+        pos++;
+        // The options of get_ports are left to Tcl
+        std::vector<std::string> ports(SplitWords(port));
+        if (ports.empty() or ports.front()[0] == '-') {
+            return false;
+        }
+        if (ports.size() == 1) {
+            port = ports.front();
+        }
+        return AtWordEnd(false);
     }
 
-    // Check if the specified port name is part of the provided connection signal
-    bool is_signal_port(RTLIL::SigSpec signal, const std::string &port_name)
+    // Split the content of curly braces into the words of a Tcl list
+    static std::vector<std::string> SplitWords(const std::string &content)
     {
-        auto port_signal = extract_signal(port_name);
-        std::string port(port_signal.first);
-        int port_bit = port_signal.second;
-        if (signal.is_chunk()) {
-            auto chunk = signal.as_chunk();
-            if (chunk.wire) {
-                return (chunk.wire->name == RTLIL::IdString(RTLIL::escape_id(port))) && (port_bit == chunk.offset);
+        std::vector<std::string> words;
+        size_t start = content.find_first_not_of(" \t\r\n");
+        while (start != std::string::npos) {
+            size_t end = content.find_first_of(" \t\r\n", start);
+            words.push_back(content.substr(start, end == std::string::npos ? std::string::npos : end - start));
+            start = content.find_first_not_of(" \t\r\n", end);
+        }
+        for (auto &word : words) {
+            if (word.find_first_of("\"") != std::string::npos) {
+                return {};
             }
         }
-        return false;
+        return words;
     }
 
-    std::function<const BankTilesMap &()> get_bank_tiles;
+    const std::string &line;
+    size_t pos;
 };
 
 struct ReadXdc : public Frontend {
+    // State of the interpreter and of set_property for the duration of a read_xdc command.
+    // It's restored on every exit, including the errors of the executed commands.
+    class Session
+    {
+      public:
+        Session(Tcl_Interp *interp, struct SetProperty &set_property, RTLIL::Design *design) : interp_(interp), set_property_(set_property)
+        {
+            Tcl_Eval(interp_, "rename unknown _original_unknown");
+            Tcl_Eval(interp_, "proc unknown args { return \\[[lindex $args 0]\\] }");
+            // The IO cells of the top module are indexed once for all the set_property commands in the file
+            set_property_.BeginSession(design);
+        }
+
+        ~Session()
+        {
+            set_property_.EndSession();
+            Tcl_Eval(interp_, "rename unknown \"\"");
+            Tcl_Eval(interp_, "rename _original_unknown unknown");
+        }
+
+      private:
+        Tcl_Interp *interp_;
+        struct SetProperty &set_property_;
+    };
+
     ReadXdc()
         : Frontend("xdc", "Read XDC file"), GetIOBanks(std::bind(&ReadXdc::get_bank_tiles, this)),
           SetProperty(std::bind(&ReadXdc::get_bank_tiles, this))
@@ -328,26 +569,56 @@ struct ReadXdc : public Frontend {
     {
         //   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
         log("\n");
-        log("    read_xdc -part_json <part_json_filename> <filename>\n");
+        log("    read_xdc -part_json <part_json_filename> [-echo|-no_echo] <filename>\n");
         log("\n");
         log("Read XDC file.\n");
         log("\n");
+        log("The set_property commands on the ports given literally, with a single property\n");
+        log("or with the -dict option, are executed directly. The other commands are\n");
+        log("evaluated by the Tcl interpreter.\n");
+        log("\n");
+        log("    -echo\n");
+        log("        Write the content of the XDC file to the log.\n");
+        log("\n");
+        log("    -no_echo\n");
+        log("        Write only the size, the number of lines and the hash of the\n");
+        log("        XDC file to the log. This is the default.\n");
+        log("\n");
     }
 
-    void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *) override
+    void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design) override
     {
         if (args.size() < 2) {
             log_cmd_error("Missing script file.\n");
         }
-        size_t argidx = 1;
+        size_t argidx;
+        bool echo = false;
         bank_tiles.clear();
-        if (args[argidx] == "-part_json" && argidx + 1 < args.size()) {
-            bank_tiles = ::get_bank_tiles(args[++argidx]);
-            argidx++;
+        for (argidx = 1; argidx < args.size(); argidx++) {
+            std::string arg = args[argidx];
+            if (arg == "-part_json" && argidx + 1 < args.size()) {
+                bank_tiles = ::get_bank_tiles(args[++argidx]);
+                continue;
+            }
+            if (arg == "-echo") {
+                echo = true;
+                continue;
+            }
+            if (arg == "-no_echo") {
+                echo = false;
+                continue;
+            }
+            break;
         }
         extra_args(f, filename, args, argidx);
-        std::string content{std::istreambuf_iterator<char>(*f), std::istreambuf_iterator<char>()};
-        log("%s\n", content.c_str());
+        // The file is read only once and the Tcl interpreter evaluates the content read here
+        FileDigest digest;
+        std::string content(read_constraints_file(*f, digest));
+        if (echo) {
+            log("%s\n", content.c_str());
+        } else {
+            log("Read %s: %s\n", filename.c_str(), digest.str().c_str());
+        }
 
         // According to page 6 of UG903 XDC is tcl, hence quoting of bracketed numbers,
         // such as bus indexes, is required. For example "signal[5]" would be typically
@@ -371,14 +642,44 @@ struct ReadXdc : public Frontend {
         // string.
         //
         Tcl_Interp *interp = yosys_get_tcl_interp();
-        Tcl_Eval(interp, "rename unknown _original_unknown");
-        Tcl_Eval(interp, "proc unknown args { return \\[[lindex $args 0]\\] }");
-        if (Tcl_EvalFile(interp, args[argidx].c_str()) != TCL_OK) {
+        TclScriptFile script_file(interp, filename);
+        Session session(interp, SetProperty, design);
+        // The simple set_property lines, which make up most of the board XDC files, are executed
+        // without the Tcl interpreter. The other lines are collected and evaluated by Tcl in order
+        // with the executed ones. A line is executed only outside of an incomplete Tcl command,
+        // so the commands in the bodies of loops or procedures are always evaluated by Tcl.
+        std::string tcl_script;
+        std::vector<std::string> command;
+        size_t line_start = 0;
+        while (line_start < content.size()) {
+            size_t line_end = std::min(content.find('\n', line_start), content.size());
+            std::string line(content, line_start, line_end - line_start);
+            line_start = line_end + 1;
+            command.clear();
+            if (XdcLineParser(line).Parse(command) and (tcl_script.empty() or Tcl_CommandComplete(tcl_script.c_str()))) {
+                eval_tcl_script(interp, tcl_script);
+                if (!command.empty()) {
+                    SetProperty.execute(command, design);
+                }
+                continue;
+            }
+            tcl_script += line;
+            tcl_script += '\n';
+        }
+        eval_tcl_script(interp, tcl_script);
+    }
+
+    void eval_tcl_script(Tcl_Interp *interp, std::string &script)
+    {
+        if (script.empty()) {
+            return;
+        }
+        if (Tcl_EvalEx(interp, script.c_str(), script.size(), 0) != TCL_OK) {
             log_cmd_error("TCL interpreter returned an error: %s\n", Tcl_GetStringResult(interp));
         }
-        Tcl_Eval(interp, "rename unknown \"\"");
-        Tcl_Eval(interp, "rename _original_unknown unknown");
+        script.clear();
     }
+
     const BankTilesMap &get_bank_tiles() { return bank_tiles; }
 
     BankTilesMap bank_tiles;